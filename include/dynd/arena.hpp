@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * A bump allocator for short-lived buffers, such as the storage of a ckernel that is
+ * built, run once and destroyed. Memory is handed out from a chain of blocks and is
+ * never freed piecewise. Instead, a ``scope`` records the current position and rewinds
+ * to it when it ends, after which the blocks are reused, so that once an arena has
+ * grown to the size a workload needs, allocating from it doesn't touch the heap.
+ *
+ * An arena must only be used by one thread at a time, and scopes on it must nest.
+ */
+class DYND_API arena {
+  struct block;
+
+  block *m_first;
+  // The block allocations are currently made from, or NULL before the first one
+  block *m_current;
+  // The number of bytes used in the current block
+  size_t m_used;
+  size_t m_block_size;
+
+public:
+  /**
+   * A position in an arena, which it can be rewound to.
+   */
+  struct mark {
+    block *current;
+    size_t used;
+  };
+
+  /**
+   * Rewinds an arena to where it was when the scope started.
+   */
+  class scope {
+    arena &m_arena;
+    mark m_mark;
+
+  public:
+    scope(arena &a) : m_arena(a), m_mark(a.get_mark()) {}
+
+    scope(const scope &) = delete;
+
+    ~scope() { m_arena.release(m_mark); }
+
+    scope &operator=(const scope &) = delete;
+  };
+
+  /**
+   * Creates an empty arena, which allocates blocks of at least ``block_size`` bytes.
+   */
+  arena(size_t block_size = 16384);
+
+  arena(const arena &) = delete;
+
+  ~arena();
+
+  arena &operator=(const arena &) = delete;
+
+  /**
+   * Returns ``size`` bytes aligned to 16 bytes. Throws ``std::bad_alloc`` if a new block
+   * is needed and can't be allocated.
+   */
+  void *allocate(size_t size);
+
+  mark get_mark() const { return mark{m_current, m_used}; }
+
+  /**
+   * Makes everything allocated since ``m`` was taken available again.
+   */
+  void release(const mark &m) {
+    m_current = m.current;
+    m_used = m.used;
+  }
+
+  /**
+   * The total number of bytes in the blocks of the arena.
+   */
+  size_t capacity() const;
+
+  /**
+   * The arena of the calling thread.
+   */
+  static arena &get();
+};
+
+} // namespace dynd
@@ -740,7 +740,30 @@ namespace nd {
   }
 
   /**
-   * Memory-maps a file with dynd type 'bytes'.
+   * Memory-maps a region of a file as an array of type ``tp``, which views the mapped
+   * pages directly without copying them. The array keeps the file mapped for as long
+   * as it, or a view of it, is alive.
+   *
+   * The type must have a fixed size, without variable-sized dimensions or data that
+   * points elsewhere, such as strings. Its outermost dimension may be ``Fixed``, in
+   * which case its size is the number of elements the region holds, e.g. mapping
+   * a file of 32 bytes as ``Fixed * {a: int64, b: float64}`` gives an array of type
+   * ``2 * {a: int64, b: float64}``.
+   *
+   * \param filename  The name of the file to memory map.
+   * \param tp  The type of the array.
+   * \param begin  If provided, the start of where to memory map. Uses
+   *               Python semantics for out of bounds and negative values.
+   * \param end  If provided, the end of where to memory map. Uses
+   *             Python semantics for out of bounds and negative values.
+   * \param access  The access permissions with which to open the file. If it includes
+   *                write_access_flag, writes to the array go to the file.
+   */
+  DYND_API array memmap(const std::string &filename, const ndt::type &tp, intptr_t begin = 0,
+                        intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = read_access_flag);
+
+  /**
+   * Memory-maps a file with dynd type ``N * uint8``.
    *
    * \param filename  The name of the file to memory map.
    * \param begin  If provided, the start of where to memory map. Uses
@@ -750,7 +773,7 @@ namespace nd {
    * \param access  The access permissions with which to open the file.
    */
   DYND_API array memmap(const std::string &filename, intptr_t begin = 0,
-                        intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = default_access_flags);
+                        intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = read_access_flag);
 
   /**
    * Creates a ctuple nd::array with the given field names and
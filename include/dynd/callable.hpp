@@ -9,6 +9,7 @@
 #include <memory>
 
 #include <dynd/callables/apply_callable_callable.hpp>
+#include <dynd/callables/prepared_call.hpp>
 #include <dynd/dispatcher.hpp>
 #include <dynd/type_registry.hpp>
 
@@ -39,6 +40,16 @@ namespace nd {
     DYND_API void check_arg(const base_callable *self, intptr_t i, const ndt::type &actual_tp,
                             const char *actual_arrmeta, std::map<std::string, ndt::type> &tp_vars);
 
+    DYND_API void check_kwd(const base_callable *self, intptr_t i, const array &value,
+                            std::map<std::string, ndt::type> &tp_vars);
+
+    /**
+     * Fills the option keyword arguments that weren't given with missing values, checking
+     * that every other keyword argument was. ``nkwd`` is the number that were given.
+     */
+    DYND_API void fill_kwds(const base_callable *self, size_t nkwd, array *kwds,
+                            const std::map<std::string, ndt::type> &tp_vars);
+
     template <template <typename...> class KernelType>
     struct make_all;
 
@@ -70,7 +81,9 @@ namespace nd {
     ndt::type resolve(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds) {
       std::map<std::string, ndt::type> tp_vars;
 
-      call_graph cg;
+      // The call graph is only needed until the type is resolved
+      arena::scope scope(arena::get());
+      call_graph cg(&arena::get());
       return m_ptr->resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
     }
 
@@ -114,6 +127,25 @@ namespace nd {
 
     array call(size_t narg, const array *args, size_t nkwd, const std::pair<const char *, array> *unordered_kwds) const;
 
+    /**
+     * Resolves and instantiates the callable once for a call signature, returning
+     * a handle that evaluates the ckernel directly. The keyword arguments are in the
+     * order of the callable's keyword parameters.
+     */
+    prepared_call prepare(const ndt::type &dst_tp, const char *dst_arrmeta, size_t nsrc, const ndt::type *src_tp,
+                          const char *const *src_arrmeta, size_t nkwd, const array *kwds,
+                          kernel_request_t kernreq = kernel_request_single) const {
+      return prepared_call(m_ptr, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, nkwd, kwds, kernreq);
+    }
+
+    /**
+     * Prepares the callable for a concrete call signature whose types have no arrmeta,
+     * such as scalars.
+     */
+    prepared_call prepare(const ndt::type &dst_tp, std::initializer_list<ndt::type> src_tp,
+                          std::initializer_list<array> kwds = {},
+                          kernel_request_t kernreq = kernel_request_single) const;
+
     template <typename... ArgTypes>
     array operator()(ArgTypes &&... args) const {
       array tmp[sizeof...(ArgTypes)] = {std::forward<ArgTypes>(args)...};
@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/comparison.hpp>
+#include <dynd/kernels/argsort_kernel.hpp>
+#include <dynd/types/option_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  class argsort_callable : public base_callable {
+    template <typename Arg0Type>
+    static void resolve_builtin(call_graph &cg, bool stable) {
+      cg.emplace_back([stable](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                               const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<builtin_argsort_kernel<Arg0Type>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, stable);
+      });
+    }
+
+  public:
+    argsort_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::type("Fixed * intptr"), {ndt::type("Fixed * Scalar")},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "stable"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+      bool stable = (nkwd == 0 || kwds == NULL || kwds[0].is_na()) ? false : kwds[0].as<bool>();
+
+      const ndt::fixed_dim_type *src0_fd = src_tp[0].extended<ndt::fixed_dim_type>();
+      ndt::type ret_tp = ndt::make_fixed_dim(src0_fd->get_fixed_dim_size(), ndt::make_type<intptr_t>());
+      const ndt::type &src0_element_tp = src0_fd->get_element_type();
+
+      // Builtin numbers are compared directly instead of through the less kernel
+      switch (src0_element_tp.get_id()) {
+      case int8_id:
+        resolve_builtin<int8_t>(cg, stable);
+        return ret_tp;
+      case int16_id:
+        resolve_builtin<int16_t>(cg, stable);
+        return ret_tp;
+      case int32_id:
+        resolve_builtin<int32_t>(cg, stable);
+        return ret_tp;
+      case int64_id:
+        resolve_builtin<int64_t>(cg, stable);
+        return ret_tp;
+      case uint8_id:
+        resolve_builtin<uint8_t>(cg, stable);
+        return ret_tp;
+      case uint16_id:
+        resolve_builtin<uint16_t>(cg, stable);
+        return ret_tp;
+      case uint32_id:
+        resolve_builtin<uint32_t>(cg, stable);
+        return ret_tp;
+      case uint64_id:
+        resolve_builtin<uint64_t>(cg, stable);
+        return ret_tp;
+      case float32_id:
+        resolve_builtin<float>(cg, stable);
+        return ret_tp;
+      case float64_id:
+        resolve_builtin<double>(cg, stable);
+        return ret_tp;
+      default:
+        break;
+      }
+
+      cg.emplace_back([stable](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                               const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<argsort_kernel>(kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+                                        reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+                                        reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
+                                        stable);
+
+        kb(kernel_request_single, nullptr, nullptr, 2, nullptr);
+      });
+
+      const ndt::type child_src_tp[2] = {src0_element_tp, src0_element_tp};
+      less->resolve(this, nullptr, cg, ndt::make_type<bool1>(), 2, child_src_tp, 0, nullptr, tp_vars);
+
+      return ret_tp;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
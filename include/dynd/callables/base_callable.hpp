@@ -10,6 +10,7 @@
 #include <typeinfo>
 
 #include <dynd/array.hpp>
+#include <dynd/callables/call_cache.hpp>
 #include <dynd/callables/call_graph.hpp>
 #include <dynd/kernels/kernel_prefix.hpp>
 #include <dynd/types/callable_type.hpp>
@@ -53,6 +54,7 @@ namespace nd {
   protected:
     std::atomic_long m_use_count;
     ndt::type m_tp;
+    call_cache m_cache;
 
   public:
     base_callable(const ndt::type &tp) : m_use_count(0), m_tp(tp) {}
@@ -90,6 +92,11 @@ namespace nd {
 
     bool is_kwd_variadic() const { return m_tp.extended<ndt::callable_type>()->is_kwd_variadic(); }
 
+    /**
+     * The cache of resolved call graphs and ckernels used by `call`.
+     */
+    call_cache &get_call_cache() { return m_cache; }
+
     /**
      * Function prototype for instantiating a kernel from an
      * callable. To use this function, the
@@ -126,11 +133,18 @@ namespace nd {
       throw std::runtime_error("callable is not specializable");
     }
 
+    /**
+     * Calls the callable into a newly allocated destination. The ckernel of the call is
+     * built in ``kernel_arena``, or in the arena of the calling thread if it is NULL, and
+     * the arena is rewound to where it was when the call returns.
+     */
     array call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
-               char *const *src_data, size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+               char *const *src_data, size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars,
+               arena *kernel_arena = NULL);
 
     array call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
-               const array *src_data, size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+               const array *src_data, size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars,
+               arena *kernel_arena = NULL);
 
     void call(const ndt::type &dst_tp, const char *dst_arrmeta, array *dst_data, size_t nsrc, const ndt::type *src_tp,
               const char *const *src_arrmeta, const array *src_data, size_t nkwd, const array *kwds,
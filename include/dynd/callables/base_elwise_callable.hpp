@@ -32,8 +32,86 @@ namespace nd {
         intptr_t res_alignment;
         size_t ndim;
         bool res_ignore;
+        size_t ncollapse;
+        bool parallel;
       };
 
+      /**
+       * Counts the dimensions following this one that a fixed dimension kernel could
+       * absorb into its loop. They all have to be fixed dimensions of the same size in
+       * every operand, without any broadcasting, so that each would otherwise be
+       * handled by its own fixed dimension kernel.
+       */
+      static size_t count_collapsible(intptr_t max_ndim, ndt::type res_tp, const ndt::type *arg_tp,
+                                      const std::vector<ndt::type> &child_arg_tp) {
+        if (N == 0) {
+          return 0;
+        }
+
+        std::array<ndt::type, N> tp;
+        for (size_t i = 0; i < N; ++i) {
+          if (arg_tp[i].get_id() != fixed_dim_id || arg_tp[i].get_ndim() - child_arg_tp[i].get_ndim() < max_ndim ||
+              arg_tp[i].extended<ndt::fixed_dim_type>()->get_fixed_dim_size() == 1) {
+            return 0;
+          }
+          tp[i] = arg_tp[i];
+        }
+
+        size_t ncollapse = 0;
+        for (intptr_t k = 1; k < max_ndim; ++k) {
+          if (res_tp.get_id() == fixed_dim_id) {
+            res_tp = res_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+          } else if (!res_tp.is_variadic()) {
+            break;
+          }
+
+          intptr_t size = -1;
+          for (size_t i = 0; i < N; ++i) {
+            tp[i] = tp[i].template extended<ndt::fixed_dim_type>()->get_element_type();
+            if (tp[i].get_id() != fixed_dim_id) {
+              return ncollapse;
+            }
+
+            intptr_t tp_size = tp[i].template extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+            if (tp_size == 1 || (size != -1 && tp_size != size)) {
+              return ncollapse;
+            }
+            size = tp_size;
+          }
+
+          if (res_tp.get_id() == fixed_dim_id && res_tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size() != size) {
+            break;
+          }
+
+          ++ncollapse;
+        }
+
+        return ncollapse;
+      }
+
+      /**
+       * Whether the outermost dimension can be split across threads. Every element
+       * has to be written separately, so neither a broadcast result nor a state is
+       * allowed, and nothing may allocate from a shared memory block, as var
+       * dimensions do.
+       */
+      static bool is_parallelizable(bool res_ignore, bool state, const ndt::type &res_tp, const ndt::type *arg_tp,
+                                    const ndt::type &child_ret_tp) {
+        if (N == 0 || res_ignore || state) {
+          return false;
+        }
+
+        uint32_t flags = child_ret_tp.get_flags();
+        if (!res_tp.is_symbolic()) {
+          flags |= res_tp.get_flags();
+        }
+        for (size_t i = 0; i < N; ++i) {
+          flags |= arg_tp[i].get_flags();
+        }
+
+        return (flags & type_flag_blockref) == 0;
+      }
+
     public:
       base_elwise_callable() : base_callable(ndt::type()) {}
 
@@ -103,6 +181,13 @@ namespace nd {
           }
         }
 
+        data.ncollapse = 0;
+        if (!res_ignore && !reinterpret_cast<codata_type *>(codata)->state) {
+          data.ncollapse = count_collapsible(max_ndim, res_tp, arg_tp, child_arg_tp);
+        }
+        data.parallel = is_parallelizable(res_ignore, reinterpret_cast<codata_type *>(codata)->state, res_tp, arg_tp,
+                                          child_ret_tp);
+
         subresolve(cg, reinterpret_cast<char *>(&data));
 
         if (--reinterpret_cast<codata_type *>(codata)->ndim > 0) {
@@ -5,11 +5,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <memory>
 
 #include <dynd/callables/base_callable.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/kernels/reduction_kernel.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/struct_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
 namespace dynd {
@@ -21,6 +25,8 @@ namespace nd {
       struct data_type {
         callable identity;
         callable child;
+        callable combiner;
+        bool full;
         bool keepdims;
         size_t naxis;
         const int *axes;
@@ -32,8 +38,117 @@ namespace nd {
         bool inner;
         bool broadcast;
         bool keepdim;
+        bool full;
+        intptr_t ninner;
       };
 
+      /**
+       * Whether partial results of type ``tp`` can be copied and merged as raw bytes, which
+       * holds for plain data and for structs of plain data, whose field offsets are in their
+       * arrmeta.
+       */
+      static bool is_mergeable(const ndt::type &tp) {
+        if (tp.is_symbolic()) {
+          return false;
+        }
+
+        if (tp.get_id() == struct_id) {
+          for (const ndt::type &field_tp : tp.extended<ndt::struct_type>()->get_field_types()) {
+            if (!field_tp.is_pod()) {
+              return false;
+            }
+          }
+          return true;
+        }
+
+        return tp.is_pod();
+      }
+
+      /**
+       * The number of bytes one partial result of type ``tp``, laid out as ``arrmeta`` says,
+       * takes up, rounded up to its alignment.
+       */
+      static size_t get_partial_size(const ndt::type &tp, const char *arrmeta) {
+        size_t data_size = tp.get_data_size();
+        if (tp.get_id() == struct_id) {
+          const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+          const std::vector<ndt::type> &field_tps = tp.extended<ndt::struct_type>()->get_field_types();
+          for (size_t i = 0; i < field_tps.size(); ++i) {
+            data_size = std::max<size_t>(data_size, data_offsets[i] + field_tps[i].get_data_size());
+          }
+        }
+
+        size_t alignment = tp.get_data_alignment();
+        return (data_size + alignment - 1) / alignment * alignment;
+      }
+
+      /**
+       * Appends the node that tells the outermost kernel of a full reduction how to
+       * merge partial results, followed by the combiner itself. Partial results can
+       * only be merged when they are plain data, using either the provided combiner
+       * or, when it accumulates into its own argument type, the reduction child.
+       */
+      static void resolve_combiner(base_callable *caller, call_graph &cg, const callable &child,
+                                   const callable &combiner, const ndt::type &ret_tp, size_t nsrc,
+                                   const ndt::type *arg_tp, size_t nkwd, const array *kwds,
+                                   const std::map<std::string, ndt::type> &tp_vars) {
+        const callable &f = combiner.is_null() ? child : combiner;
+        bool combinable = is_mergeable(ret_tp) && (!combiner.is_null() || (nsrc == 1 && arg_tp[0] == ret_tp));
+
+        cg.emplace_back([combinable, ret_tp](kernel_builder &kb, kernel_request_t DYND_UNUSED(kernreq), char *data,
+                                             const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                             const char *const *DYND_UNUSED(src_arrmeta)) {
+          kb.pass();
+
+          reduction_partials *partials = reinterpret_cast<reduction_partials *>(data);
+          partials->data_size = get_partial_size(ret_tp, dst_arrmeta);
+          if (combinable) {
+            partials->combine_offset = kb.size();
+            kb(kernel_request_strided, nullptr, dst_arrmeta, 1, &dst_arrmeta);
+          }
+        });
+
+        if (combinable) {
+          f->resolve(caller, nullptr, cg, ret_tp, 1, &ret_tp, nkwd, kwds, tp_vars);
+        }
+      }
+
+      /**
+       * The number of threads the outermost kernel of a full reduction splits a
+       * reduction over ``nelem`` elements across, where 1 keeps it serial.
+       */
+      static size_t get_nthreads(kernel_request_t kernreq, size_t nelem) {
+        if ((kernreq != kernel_request_call && kernreq != kernel_request_single) || thread_pool::in_task()) {
+          return 1;
+        }
+
+        size_t grain_size = std::max<size_t>(eval::default_eval_context.grain_size, 1);
+        return std::max<size_t>(
+            std::min(std::min(eval::default_eval_context.nthreads, thread_pool::get().get_nthreads()),
+                     nelem / grain_size),
+            1);
+      }
+
+      /**
+       * Instantiates ``nworkers`` more copies of the kernel at ``call``.
+       */
+      static kernel_builder **make_workers(size_t nworkers, call_node *call, kernel_request_t kernreq, bool partials,
+                                           const char *dst_arrmeta, size_t nsrc, const char *const *src_arrmeta) {
+        std::unique_ptr<std::unique_ptr<kernel_builder>[]> workers(new std::unique_ptr<kernel_builder>[nworkers]);
+        for (size_t i = 0; i < nworkers; ++i) {
+          reduction_partials worker_partials;
+          workers[i].reset(new kernel_builder(call));
+          (*workers[i])(kernreq, partials ? reinterpret_cast<char *>(&worker_partials) : nullptr, dst_arrmeta, nsrc,
+                        src_arrmeta);
+        }
+
+        kernel_builder **res = new kernel_builder *[nworkers];
+        for (size_t i = 0; i < nworkers; ++i) {
+          res[i] = workers[i].release();
+        }
+        return res;
+      }
+
       base_reduction_callable() : base_callable(ndt::type()) {}
 
       virtual void resolve(call_graph &cg, char *data) = 0;
@@ -54,6 +169,15 @@ namespace nd {
         }
         node.broadcast = !reduce;
         node.keepdim = reinterpret_cast<data_type *>(data)->keepdims;
+        node.full = reinterpret_cast<data_type *>(data)->full;
+        // The number of fixed dimensions directly below this one that are part of the reduction
+        node.ninner = 0;
+        ndt::type inner_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
+        for (intptr_t i = reinterpret_cast<data_type *>(data)->axis + 1;
+             i < reinterpret_cast<data_type *>(data)->ndim && inner_tp.get_id() == fixed_dim_id; ++i) {
+          ++node.ninner;
+          inner_tp = inner_tp.extended<ndt::base_dim_type>()->get_element_type();
+        }
 
         std::vector<ndt::type> arg_element_tp(2);
         for (size_t i = 0; i < nsrc; ++i) {
@@ -75,6 +199,11 @@ namespace nd {
 
           nd::callable constant = reinterpret_cast<data_type *>(data)->identity;
           constant->resolve(this, nullptr, cg, ret_element_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+
+          if (node.full) {
+            resolve_combiner(this, cg, child, reinterpret_cast<data_type *>(data)->combiner, ret_element_tp, nsrc,
+                             arg_element_tp.data(), nkwd - 2, kwds + 2, tp_vars);
+          }
         } else {
           node.inner = false;
           resolve(cg, reinterpret_cast<char *>(&node));
@@ -103,13 +232,24 @@ namespace nd {
         bool inner = reinterpret_cast<node_type *>(data)->inner;
         bool broadcast = reinterpret_cast<node_type *>(data)->broadcast;
         bool keepdim = reinterpret_cast<node_type *>(data)->keepdim;
+        bool full = reinterpret_cast<node_type *>(data)->full;
+        intptr_t ninner = reinterpret_cast<node_type *>(data)->ninner;
+
+        cg.emplace_back([inner, broadcast, keepdim, full, ninner](kernel_builder &kb, kernel_request_t kernreq,
+                                                                  char *data, const char *dst_arrmeta, size_t nsrc,
+                                                                  const char *const *src_arrmeta) {
+          // The outermost kernel of a full reduction collects how partial results are merged
+          reduction_partials outer_partials;
+          reduction_partials *partials = reinterpret_cast<reduction_partials *>(data);
+          bool outermost = full && partials == nullptr;
+          if (outermost) {
+            partials = &outer_partials;
+          }
 
-        cg.emplace_back([inner, broadcast, keepdim](kernel_builder &kb, kernel_request_t kernreq,
-                                                    char *DYND_UNUSED(data), const char *dst_arrmeta, size_t nsrc,
-                                                    const char *const *src_arrmeta) {
           if (inner) {
             if (!broadcast) {
               intptr_t src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
+              size_t nthreads = outermost ? get_nthreads(kernreq, src_size) : 1;
 
               typedef reduction_kernel<ndt::fixed_dim_type, false, true, NArg> self_type;
               intptr_t root_ckb_offset = kb.size();
@@ -124,19 +264,41 @@ namespace nd {
               for (size_t i = 0; i < NArg; ++i) {
                 e->src_stride_first[i] = 0;
               }
+              e->combine_offset = 0;
 
               const char *src_element_arrmeta[NArg];
               for (size_t i = 0; i < NArg; ++i) {
                 src_element_arrmeta[i] = src_arrmeta[i] + sizeof(size_stride_t);
               }
 
-              kb(kernel_request_strided, nullptr, dst_arrmeta + sizeof(size_stride_t), nsrc, src_element_arrmeta);
+              // A reduced dimension is only in the destination when it is kept
+              const char *child_dst_arrmeta = keepdim ? (dst_arrmeta + sizeof(size_stride_t)) : dst_arrmeta;
+
+              call_node *child_call = kb.get_call();
+              kb(kernel_request_strided, nullptr, child_dst_arrmeta, nsrc, src_element_arrmeta);
 
               intptr_t init_offset = kb.size();
-              kb(kernel_request_single, nullptr, dst_arrmeta + sizeof(size_stride_t), nsrc, src_element_arrmeta);
+              kb(kernel_request_single, nullptr, child_dst_arrmeta, nsrc, src_element_arrmeta);
 
               e = kb.get_at<self_type>(root_ckb_offset);
               e->init_offset = init_offset - root_ckb_offset;
+
+              if (full) {
+                kb(kernel_request_single, reinterpret_cast<char *>(partials), child_dst_arrmeta, nsrc, src_element_arrmeta);
+                if (partials->combine_offset != -1) {
+                  e = kb.get_at<self_type>(root_ckb_offset);
+                  e->combine_offset = partials->combine_offset - root_ckb_offset;
+                }
+              }
+
+              size_t nchunks =
+                  std::min(src_size / std::max<size_t>(eval::default_eval_context.grain_size, 1), 4 * nthreads);
+              if (nthreads > 1 && nchunks > 1 && partials->combine_offset != -1) {
+                kernel_builder **workers = make_workers(nthreads - 1, child_call, kernel_request_strided, false,
+                                                        child_dst_arrmeta, nsrc, src_element_arrmeta);
+                e = kb.get_at<self_type>(root_ckb_offset);
+                e->parallel.set(workers, nthreads - 1, nchunks, partials->data_size, e->combine_offset);
+              }
             } else {
               const char *src_element_arrmeta[NArg];
               for (size_t j = 0; j < NArg; ++j) {
@@ -178,19 +340,46 @@ namespace nd {
             }
 
             intptr_t src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
+            // A reduced dimension is only in the destination when it is kept
+            const char *child_dst_arrmeta =
+                (broadcast || keepdim) ? (dst_arrmeta + sizeof(size_stride_t)) : dst_arrmeta;
 
             if (broadcast) {
               kb.emplace_back<reduction_kernel<ndt::fixed_dim_type, true, false, NArg>>(kernreq, src_size, dst_arrmeta,
                                                                                         src_arrmeta);
-              kernreq = kernel_request_strided;
-            } else {
-              kb.emplace_back<reduction_kernel<ndt::fixed_dim_type, false, false, NArg>>(kernreq, src_size,
-                                                                                         src_arrmeta);
-              kernreq = kernel_request_single;
+              kb(kernel_request_strided, nullptr, child_dst_arrmeta, nsrc, src_element_arrmeta);
+              return;
             }
 
-            kb(kernreq, nullptr, keepdim ? (dst_arrmeta + sizeof(size_stride_t)) : dst_arrmeta, nsrc,
+            // The grain size counts elements of the whole reduction, not just of this dimension
+            size_t nthreads = 1, nchunks = 1;
+            if (outermost) {
+              size_t inner_size = 1;
+              const size_stride_t *inner_md = reinterpret_cast<const size_stride_t *>(src_element_arrmeta[0]);
+              for (intptr_t i = 0; i < ninner; ++i) {
+                inner_size *= inner_md[i].dim_size;
+              }
+
+              size_t grain_size = std::max<size_t>(eval::default_eval_context.grain_size, 1);
+              nthreads = get_nthreads(kernreq, src_size * inner_size);
+              nchunks = std::min(std::min<size_t>(src_size * inner_size / grain_size, src_size), 4 * nthreads);
+            }
+
+            typedef reduction_kernel<ndt::fixed_dim_type, false, false, NArg> self_type;
+            intptr_t root_ckb_offset = kb.size();
+            kb.emplace_back<self_type>(kernreq, src_size, src_arrmeta);
+
+            call_node *child_call = kb.get_call();
+            kb(kernel_request_single, full ? reinterpret_cast<char *>(partials) : nullptr, child_dst_arrmeta, nsrc,
                src_element_arrmeta);
+
+            if (nthreads > 1 && nchunks > 1 && partials->combine_offset != -1) {
+              kernel_builder **workers = make_workers(nthreads - 1, child_call, kernel_request_single, true,
+                                                      child_dst_arrmeta, nsrc, src_element_arrmeta);
+              self_type *e = kb.get_at<self_type>(root_ckb_offset);
+              e->parallel.set(workers, nthreads - 1, nchunks, partials->data_size,
+                              partials->combine_offset - root_ckb_offset);
+            }
           }
         });
       }
@@ -202,9 +391,10 @@ namespace nd {
         bool inner = reinterpret_cast<node_type *>(data)->inner;
         bool broadcast = reinterpret_cast<node_type *>(data)->broadcast;
         bool keepdim = reinterpret_cast<node_type *>(data)->keepdim;
-        cg.emplace_back([inner, broadcast, keepdim](kernel_builder &kb, kernel_request_t kernreq,
-                                                    char *DYND_UNUSED(data), const char *dst_arrmeta, size_t nsrc,
-                                                    const char *const *src_arrmeta) {
+        bool full = reinterpret_cast<node_type *>(data)->full;
+        cg.emplace_back([inner, broadcast, keepdim, full](kernel_builder &kb, kernel_request_t kernreq, char *data,
+                                                          const char *dst_arrmeta, size_t nsrc,
+                                                          const char *const *src_arrmeta) {
           typedef reduction_kernel<ndt::var_dim_type, false, true, NArg> self_type;
           intptr_t root_ckb_offset = kb.size();
           kb.emplace_back<self_type>(
@@ -223,6 +413,17 @@ namespace nd {
 
           e = kb.get_at<self_type>(root_ckb_offset);
           e->init_offset = init_offset - root_ckb_offset;
+
+          if (full && inner) {
+            reduction_partials outer_partials;
+            reduction_partials *partials =
+                (data == nullptr) ? &outer_partials : reinterpret_cast<reduction_partials *>(data);
+            kb(kernel_request_single, reinterpret_cast<char *>(partials), dst_arrmeta, nsrc, src_element_arrmeta);
+            if (partials->combine_offset != -1) {
+              e = kb.get_at<self_type>(root_ckb_offset);
+              e->combine_offset = partials->combine_offset - root_ckb_offset;
+            }
+          }
         });
       }
     };
@@ -0,0 +1,168 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <dynd/array.hpp>
+#include <dynd/callables/call_graph.hpp>
+#include <dynd/kernels/kernel_builder.hpp>
+
+namespace dynd {
+namespace nd {
+
+  class base_callable;
+
+  /**
+   * Counters describing how effective a callable's call cache has been.
+   */
+  struct call_cache_stats {
+    size_t hits;
+    size_t misses;
+    size_t kernel_hits;
+    size_t kernel_misses;
+    size_t evictions;
+  };
+
+  /**
+   * A bounded, thread-safe cache of resolved call graphs, owned by each
+   * callable. Entries are keyed on the requested destination type, the
+   * source types and the keyword arguments of a call, which together fully
+   * determine the result of `base_callable::resolve`.
+   *
+   * Each entry additionally holds on to the last ckernel instantiated from
+   * its call graph, together with a fingerprint of the arrmeta it was
+   * instantiated with (the arrmeta addresses and their contents). Because
+   * ckernels are free to keep pointers into the arrmeta they were built
+   * with, that ckernel is only reused when the fingerprint matches exactly,
+   * e.g. when the same arrays are passed in repeatedly. A ckernel is checked
+   * out of its entry while it runs, so concurrent callers never share one.
+   *
+   * Calls whose keyword arguments can't be compared bytewise bypass the
+   * cache.
+   */
+  class DYND_API call_cache {
+  public:
+    class entry;
+
+    /**
+     * An instantiated ckernel checked out of a cache entry. Calling
+     * `release` after a successful evaluation returns the ckernel to
+     * the entry for reuse, otherwise it is destroyed with the handle.
+     */
+    class DYND_API kernel {
+      std::shared_ptr<entry> m_entry;
+      std::unique_ptr<kernel_builder> m_kb;
+      std::string m_fingerprint;
+
+    public:
+      kernel(const std::shared_ptr<entry> &e, std::unique_ptr<kernel_builder> kb, std::string fingerprint)
+          : m_entry(e), m_kb(std::move(kb)), m_fingerprint(std::move(fingerprint)) {}
+
+      kernel_prefix *get() const { return m_kb->get(); }
+
+      void release();
+    };
+
+    class DYND_API entry {
+      friend class call_cache;
+
+      // The signature of the call
+      size_t m_hash;
+      ndt::type m_dst_tp;
+      std::vector<ndt::type> m_src_tp;
+      std::vector<array> m_kwds;
+      std::string m_kwd_bytes;
+      size_t m_epoch;
+      size_t m_last_used;
+
+      // The result of resolution
+      ndt::type m_resolved_dst_tp;
+      call_graph m_cg;
+
+      // The last ckernel instantiated from m_cg, keyed on its arrmeta fingerprint
+      std::mutex m_kernel_mutex;
+      std::string m_kernel_fingerprint;
+      std::unique_ptr<kernel_builder> m_kb;
+
+      bool matches(size_t hash, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd,
+                   const array *kwds, const std::string &kwd_bytes) const;
+
+    public:
+      entry(size_t hash, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd,
+            const array *kwds, std::string kwd_bytes);
+
+      const ndt::type &get_dst_type() const { return m_resolved_dst_tp; }
+
+      call_graph &get_call_graph() { return m_cg; }
+
+      friend class kernel;
+    };
+
+  private:
+    static std::atomic<size_t> s_epoch;
+
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<entry>> m_entries;
+    size_t m_capacity;
+    size_t m_tick;
+
+    std::atomic<size_t> m_hits;
+    std::atomic<size_t> m_misses;
+    std::atomic<size_t> m_kernel_hits;
+    std::atomic<size_t> m_kernel_misses;
+    std::atomic<size_t> m_evictions;
+
+  public:
+    static const size_t default_capacity = 16;
+
+    call_cache(size_t capacity = default_capacity);
+
+    /**
+     * Returns a resolved entry for the call signature, resolving it through
+     * `self` and caching the result on a miss. If the signature is not
+     * cacheable, a fresh entry that is not retained by the cache is returned.
+     */
+    std::shared_ptr<entry> resolve(base_callable *self, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
+                                   size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+
+    /**
+     * Instantiates a ckernel from the entry's call graph, reusing the one
+     * held by the entry if it was built for the same arrmeta.
+     */
+    kernel instantiate(const std::shared_ptr<entry> &e, kernel_request_t kernreq, const char *dst_arrmeta,
+                       size_t nsrc, const char *const *src_arrmeta);
+
+    size_t get_capacity() const { return m_capacity; }
+
+    /**
+     * Sets the maximum number of entries, evicting the least recently used
+     * ones as necessary. A capacity of 0 disables the cache.
+     */
+    void set_capacity(size_t capacity);
+
+    size_t size();
+
+    void clear();
+
+    call_cache_stats get_stats() const;
+
+    void reset_stats();
+
+    /**
+     * Invalidates the entries of every call cache. This needs to be called
+     * whenever the resolution of a callable might change, e.g. when an
+     * overload is added to a dispatching callable that others may wrap.
+     */
+    static void invalidate_all() { ++s_epoch; }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -13,6 +13,8 @@ namespace nd {
 
   class call_graph : public storagebuf<call_node, call_graph> {
   public:
+    call_graph(arena *a = nullptr) : storagebuf<call_node, call_graph>(a) {}
+
     void destroy() {}
 
     ~call_graph() {
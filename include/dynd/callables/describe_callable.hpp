@@ -0,0 +1,89 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/describe_kernel.hpp>
+#include <dynd/types/struct_type.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    inline ndt::type make_describe_type() {
+      return ndt::make_type<ndt::struct_type>(
+          {{ndt::make_type<int64>(), "count"},
+           {ndt::make_type<double>(), "sum"},
+           {ndt::make_type<double>(), "min"},
+           {ndt::make_type<double>(), "max"},
+           {ndt::make_type<double>(), "mean"},
+           {ndt::make_type<double>(), "var"}});
+    }
+
+  } // namespace dynd::nd::detail
+
+  template <typename Arg0Type>
+  class describe_callable : public base_callable {
+  public:
+    describe_callable()
+        : base_callable(
+              ndt::make_type<ndt::callable_type>(detail::make_describe_type(), {ndt::make_type<Arg0Type>()})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                      const ndt::type *DYND_UNUSED(src_tp), size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                         const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<describe_kernel<Arg0Type>>(kernreq, reinterpret_cast<const uintptr_t *>(dst_arrmeta));
+      });
+
+      return get_ret_type();
+    }
+  };
+
+  class describe_identity_callable : public base_callable {
+  public:
+    describe_identity_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(detail::make_describe_type(), {})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                      const ndt::type *DYND_UNUSED(src_tp), size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                         const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<describe_identity_kernel>(kernreq, reinterpret_cast<const uintptr_t *>(dst_arrmeta));
+      });
+
+      return get_ret_type();
+    }
+  };
+
+  class describe_combine_callable : public base_callable {
+  public:
+    describe_combine_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(detail::make_describe_type(),
+                                                           {detail::make_describe_type()})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                      const ndt::type *DYND_UNUSED(src_tp), size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<describe_combine_kernel>(kernreq, reinterpret_cast<const uintptr_t *>(dst_arrmeta),
+                                                 reinterpret_cast<const uintptr_t *>(src_arrmeta[0]));
+      });
+
+      return get_ret_type();
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
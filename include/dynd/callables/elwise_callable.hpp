@@ -5,8 +5,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/callables/base_elwise_callable.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/kernels/elwise_kernel.hpp>
 
 namespace dynd {
@@ -44,15 +49,27 @@ namespace nd {
     template <typename TraitsType, size_t N>
     class elwise_callable<fixed_dim_id, fixed_dim_id, TraitsType, N> : public base_elwise_callable<N> {
       typedef typename base_elwise_callable<N>::data_type data_type;
+      typedef elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N> kernel_type;
+
+      // Nullary kernels are never split across threads, see is_parallelizable
+      static void set_workers(std::false_type, kernel_type *DYND_UNUSED(self), kernel_builder **DYND_UNUSED(workers),
+                              size_t DYND_UNUSED(nworkers), size_t DYND_UNUSED(nchunks)) {}
+
+      static void set_workers(std::true_type, kernel_type *self, kernel_builder **workers, size_t nworkers,
+                              size_t nchunks) {
+        self->set_workers(workers, nworkers, nchunks);
+      }
 
     public:
       void subresolve(call_graph &cg, const char *data) {
         bool res_broadcast = reinterpret_cast<const data_type *>(data)->res_ignore;
         const std::array<bool, N> &arg_broadcast = reinterpret_cast<const data_type *>(data)->arg_broadcast;
+        size_t ncollapse = reinterpret_cast<const data_type *>(data)->ncollapse;
+        bool parallel = reinterpret_cast<const data_type *>(data)->parallel;
 
-        cg.emplace_back([res_broadcast, arg_broadcast](kernel_builder &kb, kernel_request_t kernreq, char *data,
-                                                       const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
-                                                       const char *const *src_arrmeta) {
+        cg.emplace_back([res_broadcast, arg_broadcast, ncollapse, parallel](
+            kernel_builder &kb, kernel_request_t kernreq, char *data, const char *dst_arrmeta,
+            size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
           size_t size;
           if (res_broadcast) {
             size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
@@ -82,10 +99,73 @@ namespace nd {
             }
           }
 
-          kb.emplace_back<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(kernreq, data, size, dst_stride,
-                                                                                    src_stride.data());
+          // Fold the following dimensions into this loop while their strides are compatible, in either
+          // C or Fortran order, so that the leaf kernel runs over the whole extent
+          size_t nskip = 0;
+          for (; nskip < ncollapse; ++nskip) {
+            const size_stride_t *dst_md = reinterpret_cast<const size_stride_t *>(child_dst_arrmeta);
+            bool c_order = dst_stride == dst_md->dim_size * dst_md->stride;
+            bool f_order = dst_md->stride == static_cast<intptr_t>(size) * dst_stride;
+            for (size_t i = 0; i < N; ++i) {
+              const size_stride_t *src_md = reinterpret_cast<const size_stride_t *>(child_src_arrmeta[i]);
+              c_order &= src_stride[i] == src_md->dim_size * src_md->stride;
+              f_order &= src_md->stride == static_cast<intptr_t>(size) * src_stride[i];
+            }
+            if (!c_order && !f_order) {
+              break;
+            }
+
+            if (c_order) {
+              dst_stride = dst_md->stride;
+              for (size_t i = 0; i < N; ++i) {
+                src_stride[i] = reinterpret_cast<const size_stride_t *>(child_src_arrmeta[i])->stride;
+              }
+            }
+            size *= dst_md->dim_size;
 
+            child_dst_arrmeta += sizeof(size_stride_t);
+            for (size_t i = 0; i < N; ++i) {
+              child_src_arrmeta[i] += sizeof(size_stride_t);
+            }
+          }
+
+          // Only the outermost loop, including any dimensions folded into it, is split
+          // across threads, and only when each thread gets at least a grain of elements
+          size_t nthreads = 1;
+          size_t grain_size = std::max<size_t>(eval::default_eval_context.grain_size, 1);
+          if (parallel && (kernreq == kernel_request_single || kernreq == kernel_request_call) &&
+              eval::default_eval_context.nthreads > 1 && !thread_pool::in_task()) {
+            nthreads = std::min(std::min(eval::default_eval_context.nthreads, thread_pool::get().get_nthreads()),
+                                size / grain_size);
+          }
+
+          size_t offset = kb.size();
+          kb.emplace_back<kernel_type>(kernreq, data, size, dst_stride, src_stride.data());
+
+          // Skip the call nodes of the folded dimensions
+          for (size_t j = 0; j < nskip; ++j) {
+            kb.pass();
+          }
+
+          call_node *child_call = kb.get_call();
           kb(kernel_request_strided, TraitsType::child_data(data), child_dst_arrmeta, N, child_src_arrmeta.data());
+
+          if (nthreads > 1) {
+            // Every other thread runs its own copy of the child kernel
+            std::unique_ptr<std::unique_ptr<kernel_builder>[]> workers(new std::unique_ptr<kernel_builder>[nthreads - 1]);
+            for (size_t j = 0; j < nthreads - 1; ++j) {
+              workers[j].reset(new kernel_builder(child_call));
+              (*workers[j])(kernel_request_strided, TraitsType::child_data(data), child_dst_arrmeta, N,
+                            child_src_arrmeta.data());
+            }
+
+            kernel_builder **raw_workers = new kernel_builder *[nthreads - 1];
+            for (size_t j = 0; j < nthreads - 1; ++j) {
+              raw_workers[j] = workers[j].release();
+            }
+            set_workers(std::integral_constant<bool, (N > 0)>(), kb.get_at<kernel_type>(offset), raw_workers,
+                        nthreads - 1, std::min(size / grain_size, 4 * nthreads));
+          }
         });
       }
 
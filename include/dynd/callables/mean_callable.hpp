@@ -5,50 +5,87 @@
 
 #pragma once
 
+#include <algorithm>
+#include <sstream>
+
+#include <dynd/arithmetic.hpp>
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/mean_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
 
 namespace dynd {
 namespace nd {
 
+  /**
+   * The mean as the sum over the reduced axes, divided in place by the number of elements
+   * it added. The sum is resolved with the same keywords, so the axes and the summation mode
+   * apply to both.
+   */
   class mean_callable : public base_callable {
     ndt::type m_tp;
 
   public:
     mean_callable(const ndt::type &tp)
-        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::any_kind_type>(),
-                                                           {ndt::make_type<ndt::any_kind_type>()})),
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<ndt::any_kind_type>(), {ndt::make_type<ndt::any_kind_type>()},
+              {{ndt::make_type<ndt::option_type>(ndt::type("Fixed * int32")), "axes"},
+               {ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "keepdims"},
+               {ndt::make_type<ndt::option_type>(ndt::make_type<summation_mode>()), "summation"}})),
           m_tp(tp) {}
 
-    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-      return dst_tp;
-    }
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      const int *axes = nullptr;
+      intptr_t naxis = 0;
+      if (nkwd != 0 && kwds != NULL && !kwds[0].is_na()) {
+        axes = reinterpret_cast<const int *>(kwds[0].cdata());
+        naxis = kwds[0].get_dim_size();
+      }
+
+      // The number of elements summed into each value of the result
+      int64 count = 1;
+      ndt::type tp = src_tp[0];
+      for (intptr_t i = 0, ndim = src_tp[0].get_ndim(); i < ndim; ++i) {
+        if (tp.get_id() != fixed_dim_id) {
+          std::stringstream ss;
+          ss << "mean: only fixed dimensions are supported, got " << src_tp[0];
+          throw std::invalid_argument(ss.str());
+        }
 
-    /*
-        void instantiate(call_node *&node, char *data, kernel_builder *ckb, const ndt::type &dst_tp,
-                         const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp, const char *const
-       *src_arrmeta,
-                         kernel_request_t kernreq, intptr_t nkwd, const array *kwds,
-                         const std::map<std::string, ndt::type> &tp_vars) {
-          intptr_t mean_offset = ckb->size();
-          ckb->emplace_back<mean_kernel>(kernreq, src_tp[0].get_size(src_arrmeta[0]));
-          node = next(node);
-
-          nd::sum->instantiate(node, reinterpret_cast<data_type *>(data)->sum_data, ckb, dst_tp, dst_arrmeta, nsrc,
-       src_tp,
-                               src_arrmeta, kernreq, nkwd, kwds, tp_vars);
-
-          mean_kernel *self = ckb->get_at<mean_kernel>(mean_offset);
-          self->compound_div_offset = ckb->size();
-          nd::compound_div->instantiate(node, reinterpret_cast<data_type *>(data)->compound_div_data, ckb, dst_tp,
-                                        dst_arrmeta, 1, &m_tp, NULL, kernreq, nkwd, kwds, tp_vars);
-
-          delete reinterpret_cast<data_type *>(data);
+        if (axes == nullptr || std::find(axes, axes + naxis, i) != axes + naxis) {
+          count *= tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
         }
-    */
+        tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      }
+
+      cg.emplace_back([count](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                              const char *dst_arrmeta, size_t nsrc, const char *const *src_arrmeta) {
+        intptr_t mean_offset = kb.size();
+        kb.emplace_back<mean_kernel>(kernreq, count);
+
+        kb(kernel_request_single, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+
+        intptr_t compound_div_offset = kb.size();
+        kb.get_at<mean_kernel>(mean_offset)->compound_div_offset = compound_div_offset - mean_offset;
+
+        const char *child_src_arrmeta[1] = {nullptr};
+        kb(kernel_request_single, nullptr, dst_arrmeta, 1, child_src_arrmeta);
+      });
+
+      ndt::type ret_tp = nd::sum->resolve(this, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+      type_id_t ret_base_id = ret_tp.get_dtype().get_base_id();
+      if (ret_base_id != float_kind_id && ret_base_id != complex_kind_id) {
+        std::stringstream ss;
+        ss << "mean: the sum of " << src_tp[0] << " is " << ret_tp << ", which is not a floating point type";
+        throw std::invalid_argument(ss.str());
+      }
+
+      nd::compound_div->resolve(this, nullptr, cg, ret_tp, 1, &m_tp, 0, nullptr, tp_vars);
+
+      return ret_tp;
+    }
   };
 
 } // namespace dynd::nd
@@ -23,6 +23,7 @@ namespace nd {
 
     void overload(const callable &value) {
       m_dispatcher.insert(value);
+      call_cache::invalidate_all();
     }
 
     const callable &specialize(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) {
@@ -40,6 +41,7 @@ namespace nd {
 
     void overload(const callable &value) {
       m_dispatcher.insert(value);
+      call_cache::invalidate_all();
     }
 
     const callable &specialize(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) {
@@ -0,0 +1,91 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <memory>
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/kernel_builder.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * An owning handle to a ckernel that has been resolved and instantiated
+   * once for a fixed call signature, so it can be evaluated repeatedly
+   * without going through `base_callable::call`.
+   *
+   * The ckernel may keep pointers into the arrmeta it was instantiated with,
+   * so that arrmeta must outlive the handle. A handle is not safe to evaluate
+   * from several threads at once, as ckernels are free to keep state.
+   */
+  class DYND_API prepared_call {
+    std::shared_ptr<call_cache::entry> m_entry;
+    std::unique_ptr<kernel_builder> m_kb;
+    kernel_request_t m_kernreq;
+
+  public:
+    /**
+     * Resolves `self` for the call signature and instantiates its ckernel.
+     *
+     * \param self  The callable to prepare.
+     * \param dst_tp  The requested destination type.
+     * \param dst_arrmeta  The arrmeta of the destination, which must match the resolved
+     *                     destination type.
+     * \param nsrc  The number of source arrays.
+     * \param src_tp  The source types.
+     * \param src_arrmeta  The arrmeta of the sources.
+     * \param nkwd  The number of keyword arguments.
+     * \param kwds  The keyword arguments, in the order of the callable's keyword parameters.
+     *              Trailing ones may be left out, and null ones are treated as not given,
+     *              with option parameters taking missing values as in a call.
+     * \param kernreq  Either `kernel_request_single` or `kernel_request_strided`.
+     */
+    prepared_call(base_callable *self, const ndt::type &dst_tp, const char *dst_arrmeta, size_t nsrc,
+                  const ndt::type *src_tp, const char *const *src_arrmeta, size_t nkwd, const array *kwds,
+                  kernel_request_t kernreq);
+
+    prepared_call(prepared_call &&) = default;
+
+    prepared_call &operator=(prepared_call &&) = default;
+
+    /**
+     * The destination type the callable resolved to.
+     */
+    const ndt::type &get_dst_type() const { return m_entry->get_dst_type(); }
+
+    kernel_request_t get_kernel_request() const { return m_kernreq; }
+
+    kernel_prefix *get() const { return m_kb->get(); }
+
+    /**
+     * Evaluates the ckernel on one element, which requires it to have been
+     * prepared with `kernel_request_single`.
+     */
+    void operator()(char *dst, char *const *src) const {
+      if (m_kernreq != kernel_request_single) {
+        throw std::runtime_error("prepared call was not instantiated with kernel_request_single");
+      }
+
+      m_kb->get()->single(dst, src);
+    }
+
+    /**
+     * Evaluates the ckernel on `count` strided elements, which requires it to
+     * have been prepared with `kernel_request_strided`.
+     */
+    void operator()(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                    size_t count) const {
+      if (m_kernreq != kernel_request_strided) {
+        throw std::runtime_error("prepared call was not instantiated with kernel_request_strided");
+      }
+
+      m_kb->get()->strided(dst, dst_stride, src, src_stride, count);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/callables/base_reduction_callable.hpp>
 #include <dynd/kernels/reduction_kernel.hpp>
@@ -16,10 +18,12 @@ namespace nd {
     class reduction_dispatch_callable : public base_callable {
       callable m_identity;
       callable m_child;
+      callable m_combiner;
 
     public:
-      reduction_dispatch_callable(const ndt::type &tp, const callable &identity, const callable &child)
-          : base_callable(tp), m_identity(identity), m_child(child) {}
+      reduction_dispatch_callable(const ndt::type &tp, const callable &identity, const callable &child,
+                                  const callable &combiner = callable())
+          : base_callable(tp), m_identity(identity), m_child(child), m_combiner(combiner) {}
 
       typedef typename base_reduction_callable::data_type new_data_type;
 
@@ -30,6 +34,7 @@ namespace nd {
         if (data == nullptr) {
           new_data.identity = m_identity;
           new_data.child = m_child;
+          new_data.combiner = m_combiner;
           if (kwds[0].is_na()) {
             new_data.naxis = src_tp[0].get_ndim() - m_child->get_ret_type().get_ndim();
             new_data.axes = NULL;
@@ -48,6 +53,12 @@ namespace nd {
           new_data.ndim = ndim;
           new_data.axis = 0;
 
+          // Whether every dimension is reduced, leaving a single value
+          new_data.full = true;
+          for (intptr_t i = 0; i < ndim && new_data.full && new_data.axes != NULL; ++i) {
+            new_data.full = std::find(new_data.axes, new_data.axes + new_data.naxis, i) != new_data.axes + new_data.naxis;
+          }
+
           data = reinterpret_cast<char *>(&new_data);
         }
 
@@ -13,6 +13,17 @@ namespace dynd {
 namespace nd {
 
   class sort_callable : public base_callable {
+    template <typename Arg0Type>
+    static void resolve_builtin(call_graph &cg) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                         const char *const *src_arrmeta) {
+        kb.emplace_back<builtin_sort_kernel<Arg0Type>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
+      });
+    }
+
   public:
     sort_callable()
         : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {ndt::type("Fixed * Scalar")})) {}
@@ -22,6 +33,43 @@ namespace nd {
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
       const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+
+      // Builtin numbers are sorted directly instead of through the less kernel
+      switch (src0_element_tp.get_id()) {
+      case int8_id:
+        resolve_builtin<int8_t>(cg);
+        return dst_tp;
+      case int16_id:
+        resolve_builtin<int16_t>(cg);
+        return dst_tp;
+      case int32_id:
+        resolve_builtin<int32_t>(cg);
+        return dst_tp;
+      case int64_id:
+        resolve_builtin<int64_t>(cg);
+        return dst_tp;
+      case uint8_id:
+        resolve_builtin<uint8_t>(cg);
+        return dst_tp;
+      case uint16_id:
+        resolve_builtin<uint16_t>(cg);
+        return dst_tp;
+      case uint32_id:
+        resolve_builtin<uint32_t>(cg);
+        return dst_tp;
+      case uint64_id:
+        resolve_builtin<uint64_t>(cg);
+        return dst_tp;
+      case float32_id:
+        resolve_builtin<float>(cg);
+        return dst_tp;
+      case float64_id:
+        resolve_builtin<double>(cg);
+        return dst_tp;
+      default:
+        break;
+      }
+
       size_t src0_element_data_size = src0_element_tp.get_data_size();
       cg.emplace_back([src0_element_data_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
                                                const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
@@ -5,18 +5,44 @@
 
 #pragma once
 
+#include <dynd/callables/base_callable.hpp>
 #include <dynd/callables/default_instantiable_callable.hpp>
 #include <dynd/kernels/sum_kernel.hpp>
+#include <dynd/types/option_type.hpp>
 
 namespace dynd {
 namespace nd {
 
   template <typename Arg0Type>
-  class sum_callable : public default_instantiable_callable<sum_kernel<Arg0Type>> {
+  class sum_callable : public base_callable {
   public:
     sum_callable()
-        : default_instantiable_callable<sum_kernel<Arg0Type>>(ndt::make_type<ndt::callable_type>(
-              ndt::make_type<typename nd::sum_kernel<Arg0Type>::dst_type>(), {ndt::make_type<Arg0Type>()})) {}
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<typename nd::sum_kernel<Arg0Type>::dst_type>(), {ndt::make_type<Arg0Type>()},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<summation_mode>()), "summation"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                      size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      summation_mode mode =
+          (nkwd == 0 || kwds == NULL || kwds[0].is_na()) ? summation_pairwise : kwds[0].as<summation_mode>();
+
+      cg.emplace_back([mode](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                             const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                             const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<sum_kernel<Arg0Type>>(kernreq, mode);
+      });
+
+      return dst_tp;
+    }
+  };
+
+  template <typename T>
+  class sum_identity_callable : public default_instantiable_callable<sum_identity_kernel<T>> {
+  public:
+    sum_identity_callable()
+        : default_instantiable_callable<sum_identity_kernel<T>>(
+              ndt::make_type<ndt::callable_type>(ndt::make_type<T>(), {})) {}
   };
 
 } // namespace dynd::nd
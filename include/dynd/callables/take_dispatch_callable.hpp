@@ -29,8 +29,13 @@ namespace nd {
                       const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
-      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
-                         size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+      ndt::type src0_element_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
+      // Builtin elements are copied by the kernel itself, when their layout allows
+      intptr_t element_size = src0_element_tp.is_builtin() ? src0_element_tp.get_data_size() : 0;
+
+      cg.emplace_back([element_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                     const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                     const char *const *src_arrmeta) {
         typedef nd::masked_take_ck self_type;
 
         intptr_t ckb_offset = kb.size();
@@ -53,13 +58,12 @@ namespace nd {
           throw std::invalid_argument(ss.str());
         }
         self->m_dim_size = src0_dim_size;
+        self->m_element_size = element_size;
 
         // Create the child element assignment ckernel
         kb(kernel_request_strided, nullptr, dst_arrmeta + sizeof(ndt::var_dim_type::metadata_type), 1, &src0_el_meta);
       });
 
-      ndt::type src0_element_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
-
       nd::array error_mode = assign_error_default;
       assign->resolve(this, nullptr, cg, src0_element_tp, 1, &src0_element_tp, 1, &error_mode, tp_vars);
 
@@ -80,9 +84,6 @@ namespace nd {
 
       ndt::type src0_element_tp = src_tp[0].get_type_at_dimension(NULL, 1).get_canonical_type();
 
-      nd::array error_mode = assign_error_default;
-      assign->resolve(this, nullptr, cg, src0_element_tp, 1, &src0_element_tp, 1, &error_mode, tp_vars);
-
       ndt::type resolved_dst_tp;
       if (src_tp[1].get_id() == var_dim_id) {
         resolved_dst_tp = ndt::make_type<ndt::var_dim_type>(src0_element_tp);
@@ -90,18 +91,26 @@ namespace nd {
         resolved_dst_tp = ndt::make_fixed_dim(src_tp[1].get_dim_size(NULL, NULL), src0_element_tp);
       }
 
+      // Builtin elements are copied by the kernel itself
+      intptr_t element_size = src0_element_tp.is_builtin() ? src0_element_tp.get_data_size() : 0;
+
+      // The source types are captured by value, as the call graph outlives the caller's array of them
+      ndt::type src0_tp = src_tp[0], src1_tp = src_tp[1];
+
       cg.emplace_back([=](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
                           const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
         intptr_t self_offset = kb.size();
         kb.emplace_back<indexed_take_ck>(kernreq);
 
         indexed_take_ck *self = kb.get_at<indexed_take_ck>(self_offset);
+        self->m_element_size = element_size;
 
         ndt::type dst_el_tp;
         const char *dst_el_meta;
-        if (!dst_tp.get_as_strided(dst_arrmeta, &self->m_dst_dim_size, &self->m_dst_stride, &dst_el_tp, &dst_el_meta)) {
+        if (!resolved_dst_tp.get_as_strided(dst_arrmeta, &self->m_dst_dim_size, &self->m_dst_stride, &dst_el_tp,
+                                            &dst_el_meta)) {
           std::stringstream ss;
-          ss << "indexed take arrfunc: could not process type " << dst_tp;
+          ss << "indexed take arrfunc: could not process type " << resolved_dst_tp;
           ss << " as a strided dimension";
           throw type_error(ss.str());
         }
@@ -109,17 +118,17 @@ namespace nd {
         intptr_t index_dim_size;
         ndt::type src0_el_tp, index_el_tp;
         const char *src0_el_meta, *index_el_meta;
-        if (!src_tp[0].get_as_strided(src_arrmeta[0], &self->m_src0_dim_size, &self->m_src0_stride, &src0_el_tp,
-                                      &src0_el_meta)) {
+        if (!src0_tp.get_as_strided(src_arrmeta[0], &self->m_src0_dim_size, &self->m_src0_stride, &src0_el_tp,
+                                    &src0_el_meta)) {
           std::stringstream ss;
-          ss << "indexed take arrfunc: could not process type " << src_tp[0];
+          ss << "indexed take arrfunc: could not process type " << src0_tp;
           ss << " as a strided dimension";
           throw type_error(ss.str());
         }
-        if (!src_tp[1].get_as_strided(src_arrmeta[1], &index_dim_size, &self->m_index_stride, &index_el_tp,
-                                      &index_el_meta)) {
+        if (!src1_tp.get_as_strided(src_arrmeta[1], &index_dim_size, &self->m_index_stride, &index_el_tp,
+                                    &index_el_meta)) {
           std::stringstream ss;
-          ss << "take arrfunc: could not process type " << src_tp[1];
+          ss << "take arrfunc: could not process type " << src1_tp;
           ss << " as a strided dimension";
           throw type_error(ss.str());
         }
@@ -140,6 +149,9 @@ namespace nd {
         kb(kernel_request_single, nullptr, dst_el_meta, 1, &src0_el_meta);
       });
 
+      nd::array error_mode = assign_error_default;
+      assign->resolve(this, nullptr, cg, src0_element_tp, 1, &src0_element_tp, 1, &error_mode, tp_vars);
+
       return resolved_dst_tp;
     }
 
@@ -7,40 +7,119 @@
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/unique_kernel.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
 
 namespace dynd {
 namespace nd {
 
   class unique_callable : public base_callable {
+    template <typename Arg0Type>
+    static void resolve_kernel(call_graph &cg, const ndt::type &ret_tp, bool counts, bool inverse) {
+      cg.emplace_back([ret_tp, counts, inverse](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                                const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                                const char *const *src_arrmeta) {
+        intptr_t offsets[3] = {0, -1, -1};
+        const char *arrmeta[3] = {dst_arrmeta, NULL, NULL};
+        if (counts || inverse) {
+          // The outputs are the fields of a struct, in the order they are listed
+          const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(dst_arrmeta);
+          const uintptr_t *arrmeta_offsets = ret_tp.extended<ndt::struct_type>()->get_arrmeta_offsets_raw();
+          intptr_t j = 0;
+          for (intptr_t i = 0; i < 3; ++i) {
+            if (i == 0 || (i == 1 && counts) || (i == 2 && inverse)) {
+              offsets[i] = data_offsets[j];
+              arrmeta[i] = dst_arrmeta + arrmeta_offsets[j];
+              ++j;
+            }
+          }
+        }
+
+        kb.emplace_back<unique_kernel<Arg0Type>>(
+            kernreq, offsets[0], offsets[1], offsets[2],
+            reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta[0]),
+            reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta[1]),
+            inverse ? reinterpret_cast<const size_stride_t *>(arrmeta[2])->stride : 0,
+            reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->stride);
+      });
+    }
+
   public:
     unique_callable()
-        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {ndt::type("Fixed * Scalar")})) {}
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<ndt::any_kind_type>(), {ndt::type("Fixed * Scalar")},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "counts"},
+               {ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "inverse"}})) {}
 
-    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-      return dst_tp;
-    }
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      bool counts = (nkwd < 1 || kwds == NULL || kwds[0].is_na()) ? false : kwds[0].as<bool>();
+      bool inverse = (nkwd < 2 || kwds == NULL || kwds[1].is_na()) ? false : kwds[1].as<bool>();
 
-    /*
-        void instantiate(call_node *&node, char *data, kernel_builder *ckb, const ndt::type &DYND_UNUSED(dst_tp),
-                         const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
-                         const char *const *src_arrmeta, kernel_request_t kernreq, intptr_t nkwd, const nd::array *kwds,
-                         const std::map<std::string, ndt::type> &tp_vars) {
-          const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
-          ckb->emplace_back<unique_kernel>(
-              kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-              reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
-       src0_element_tp.get_data_size());
-          node = next(node);
-
-          const ndt::type equal_src_tp[2] = {src0_element_tp, src0_element_tp};
-          equal->instantiate(node, data, ckb, ndt::make_type<bool1>(), NULL, 2, equal_src_tp, NULL,
-       kernel_request_single,
-                             nkwd, kwds, tp_vars);
+      const ndt::fixed_dim_type *src0_fd = src_tp[0].extended<ndt::fixed_dim_type>();
+      const ndt::type &src0_element_tp = src0_fd->get_element_type();
+
+      ndt::type ret_tp = ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+      if (counts || inverse) {
+        std::vector<std::pair<ndt::type, std::string>> fields{{ret_tp, "values"}};
+        if (counts) {
+          fields.push_back({ndt::make_type<ndt::var_dim_type>(ndt::make_type<intptr_t>()), "counts"});
+        }
+        if (inverse) {
+          fields.push_back({ndt::make_fixed_dim(src0_fd->get_fixed_dim_size(), ndt::make_type<intptr_t>()), "inverse"});
         }
-    */
+        ret_tp = ndt::make_type<ndt::struct_type>(fields);
+      }
+
+      switch (src0_element_tp.get_id()) {
+      case bool_id:
+        resolve_kernel<bool1>(cg, ret_tp, counts, inverse);
+        break;
+      case int8_id:
+        resolve_kernel<int8_t>(cg, ret_tp, counts, inverse);
+        break;
+      case int16_id:
+        resolve_kernel<int16_t>(cg, ret_tp, counts, inverse);
+        break;
+      case int32_id:
+        resolve_kernel<int32_t>(cg, ret_tp, counts, inverse);
+        break;
+      case int64_id:
+        resolve_kernel<int64_t>(cg, ret_tp, counts, inverse);
+        break;
+      case uint8_id:
+        resolve_kernel<uint8_t>(cg, ret_tp, counts, inverse);
+        break;
+      case uint16_id:
+        resolve_kernel<uint16_t>(cg, ret_tp, counts, inverse);
+        break;
+      case uint32_id:
+        resolve_kernel<uint32_t>(cg, ret_tp, counts, inverse);
+        break;
+      case uint64_id:
+        resolve_kernel<uint64_t>(cg, ret_tp, counts, inverse);
+        break;
+      case float32_id:
+        resolve_kernel<float>(cg, ret_tp, counts, inverse);
+        break;
+      case float64_id:
+        resolve_kernel<double>(cg, ret_tp, counts, inverse);
+        break;
+      case string_id:
+        resolve_kernel<string>(cg, ret_tp, counts, inverse);
+        break;
+      default: {
+        std::stringstream ss;
+        ss << "unique: unsupported element type " << src0_element_tp;
+        throw type_error(ss.str());
+      }
+      }
+
+      return ret_tp;
+    }
   };
 
 } // namespace dynd::nd
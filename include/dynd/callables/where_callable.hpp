@@ -39,7 +39,7 @@ namespace nd {
             kernreq, data, reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->stride,
             reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->blockref);
 
-        kb(kernel_request_single, nullptr, nullptr, nsrc - 1, src_arrmeta);
+        kb(kernel_request_strided, nullptr, nullptr, nsrc - 1, src_arrmeta);
       });
 
       m_child->resolve(this, nullptr, cg, ndt::make_type<bool>(), nsrc - 1, src_tp, nkwd, kwds, tp_vars);
@@ -19,13 +19,13 @@ typedef dynd::type_sequence<bool, int8_t, int16_t, int32_t, int64_t, uint8_t, ui
                             double>
     numeric_types;
 
-static std::vector<dynd::ndt::type> func_ptr(const dynd::ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-                                             const dynd::ndt::type *src_tp) {
-  return {src_tp[0], src_tp[1]};
+static void func_ptr(const dynd::ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                     const dynd::ndt::type *src_tp, dynd::ndt::type *res) {
+  res[0] = src_tp[0];
+  res[1] = src_tp[1];
 }
 
-template <std::vector<dynd::ndt::type> (*Func)(const dynd::ndt::type &, size_t, const dynd::ndt::type *),
-          template <typename...> class KernelType>
+template <dynd::dispatch_t Func, template <typename...> class KernelType>
 dynd::dispatcher<2, dynd::nd::callable> make_comparison_children() {
   static const std::vector<dynd::ndt::type> numeric_dyn_types = {
       dynd::ndt::make_type<bool>(),     dynd::ndt::make_type<int8_t>(),   dynd::ndt::make_type<int16_t>(),
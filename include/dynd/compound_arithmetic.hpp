@@ -25,8 +25,9 @@ nd::callable make_compound_arithmetic() {
       ndt::make_type<ndt::struct_type>());
 
   auto dispatcher = nd::callable::make_all<KernelType, TypeSequence, TypeSequence>(
-      [](const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp) -> std::vector<ndt::type> {
-        return {dst_tp, src_tp[0]};
+      [](const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, ndt::type *res) {
+        res[0] = dst_tp;
+        res[1] = src_tp[0];
       });
 
   static const std::vector<ndt::type> binop_ids = {ndt::make_type<uint8_t>(),
@@ -47,6 +47,8 @@
 #define DYND_USED(NAME) NAME __attribute__((used))
 #define DYND_EMIT_LLVM(NAME) __attribute__((annotate(#NAME), annotate("emit_llvm"))) NAME
 
+#define DYND_PREFETCH(ADDR) __builtin_prefetch(ADDR)
+
 #define DYND_ALLOW_UNSIGNED_UNARY_MINUS
 #define DYND_END_ALLOW_UNSIGNED_UNARY_MINUS
 
@@ -70,6 +72,8 @@
 #define DYND_USED(NAME) NAME
 #define DYND_EMIT_LLVM(NAME) NAME
 
+#define DYND_PREFETCH(ADDR) __builtin_prefetch(ADDR)
+
 // Ignore erroneous maybe-uninitizlized
 // warnings on a given line or code block.
 #define DYND_IGNORE_MAYBE_UNINITIALIZED _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
@@ -542,6 +546,11 @@ typedef uintptr_t offset_t;
 #define DYND_IGNORE_UNUSED(NAME) NAME
 #endif
 
+// Hints that the memory at an address will be read soon, where the compiler supports it
+#ifndef DYND_PREFETCH
+#define DYND_PREFETCH(ADDR)
+#endif
+
 #ifndef DYND_IGNORE_MAYBE_UNINITIALIZED
 #define DYND_IGNORE_MAYBE_UNINITIALIZED
 #define DYND_END_IGNORE_MAYBE_UNINITIALIZED
@@ -858,6 +867,37 @@ inline std::ostream &operator<<(std::ostream &o, assign_error_mode errmode) {
   return o;
 }
 
+/**
+ * An enumeration for how a sum accumulates a run of values.
+ */
+enum summation_mode {
+  /** Adds the values one after another, in order */
+  summation_serial,
+  /** Adds blocks of values into independent accumulators, then adds the block sums pairwise */
+  summation_pairwise,
+  /** Adds the values in order, carrying a compensation term for the low-order bits lost to rounding */
+  summation_kahan
+};
+
+inline std::ostream &operator<<(std::ostream &o, summation_mode mode) {
+  switch (mode) {
+  case summation_serial:
+    o << "serial";
+    break;
+  case summation_pairwise:
+    o << "pairwise";
+    break;
+  case summation_kahan:
+    o << "kahan";
+    break;
+  default:
+    o << "invalid summation mode(" << (int)mode << ")";
+    break;
+  }
+
+  return o;
+}
+
 namespace detail {
   // Use these declarations before includeing bool1, int128, uint128, etc. so they are usable there.
   // Helper to use for determining if a type is in a given list of unique types.
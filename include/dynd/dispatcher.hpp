@@ -5,25 +5,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
-
-// #include <sparsehash/dense_hash_map>
+#include <mutex>
 
 #include <dynd/type_registry.hpp>
 
 namespace dynd {
 
-typedef std::vector<ndt::type> (*dispatch_t)(const ndt::type &, size_t, const ndt::type *);
-
-template <size_t N>
-std::array<ndt::type, N> as_array(const std::vector<ndt::type> &in) {
-  std::array<ndt::type, N> out;
-  for (size_t i = 0; i < N; ++i) {
-    out[i] = in[i];
-  }
+/**
+ * Selects the types a dispatcher keys on from a signature, writing one per
+ * dispatched position into res. It runs on every lookup, so it must not allocate.
+ */
+typedef void (*dispatch_t)(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, ndt::type *res);
 
-  return out;
-}
 template <size_t N>
 bool ambiguous(const std::array<type_id_t, N> &lhs, const std::array<type_id_t, N> &rhs) {
   return consistent(lhs, rhs) && !(supercedes(lhs, rhs) || supercedes(rhs, lhs));
@@ -132,22 +127,116 @@ inline std::ostream &print_ids(std::ostream &o, size_t nids, const ndt::type *tp
 
 template <size_t N, typename T>
 class dispatcher {
-  typedef std::map<size_t, T> Map;
-
 public:
   typedef T value_type;
 
-  typedef Map map_type;
-  //  typedef google::dense_hash_map<size_t, value_type> map_type;
-
   typedef typename std::vector<T>::iterator iterator;
   typedef typename std::vector<T>::const_iterator const_iterator;
 
 private:
+  /**
+   * A slot of the open-addressing dispatch table, mapping the type ids of a
+   * signature to the index of the winning child. An index of -1 marks an
+   * empty slot. A slot is written once, ids first and then the index with
+   * release semantics, so a lookup that sees the index also sees the ids.
+   */
+  struct slot {
+    std::array<type_id_t, N> ids;
+    std::atomic<intptr_t> index{-1};
+  };
+
+  struct table {
+    size_t capacity;
+    size_t size;
+    std::unique_ptr<slot[]> slots;
+
+    table(size_t capacity) : capacity(capacity), size(0), slots(new slot[capacity]) {}
+
+    /**
+     * Returns the index of the child cached for the ids, or -1 if there is none.
+     * Safe to call concurrently with insert.
+     */
+    intptr_t find(size_t key, const std::array<type_id_t, N> &ids) const {
+      size_t mask = capacity - 1;
+      for (size_t i = key & mask;; i = (i + 1) & mask) {
+        const slot &s = slots[i];
+        intptr_t index = s.index.load(std::memory_order_acquire);
+        if (index == -1 || s.ids == ids) {
+          return index;
+        }
+      }
+    }
+
+    /**
+     * Caches the child index for the ids, which must not be present. The map
+     * mutex must be held and the table must have room.
+     */
+    void insert(size_t key, const std::array<type_id_t, N> &ids, intptr_t index) {
+      size_t mask = capacity - 1;
+      for (size_t i = key & mask;; i = (i + 1) & mask) {
+        slot &s = slots[i];
+        if (s.index.load(std::memory_order_relaxed) == -1) {
+          s.ids = ids;
+          s.index.store(index, std::memory_order_release);
+          ++size;
+          return;
+        }
+      }
+    }
+  };
+
   std::vector<T> m_children;
-  //  map_type m_map;
+  std::vector<std::array<ndt::type, N>> m_signatures;
   dispatch_t m_dispatch;
 
+  // Cache of previous dispatches on builtin types, whose ids identify them completely. Lookups
+  // read the current table without locking; misses insert into it under the mutex, replacing it
+  // with a larger copy when it's half full. Replaced tables may still be read by a concurrent
+  // lookup, so they're kept until the dispatcher is destroyed; they grow geometrically, so
+  // this at most doubles the memory in use.
+  std::mutex m_map_mutex;
+  std::atomic<table *> m_map;
+  std::vector<std::unique_ptr<table>> m_maps;
+
+  /**
+   * Caches the child index for the ids, unless another thread already has.
+   */
+  void emplace(size_t key, const std::array<type_id_t, N> &ids, intptr_t index) {
+    std::lock_guard<std::mutex> lock(m_map_mutex);
+
+    table *map = m_map.load(std::memory_order_relaxed);
+    if (map != nullptr && map->find(key, ids) != -1) {
+      return;
+    }
+
+    if (map == nullptr || 2 * (map->size + 1) > map->capacity) {
+      std::unique_ptr<table> new_map = std::make_unique<table>(map == nullptr ? 16 : 2 * map->capacity);
+      if (map != nullptr) {
+        for (size_t i = 0; i < map->capacity; ++i) {
+          const slot &s = map->slots[i];
+          intptr_t j = s.index.load(std::memory_order_relaxed);
+          if (j != -1) {
+            new_map->insert(hash(s.ids), s.ids, j);
+          }
+        }
+      }
+      new_map->insert(key, ids, index);
+
+      m_map.store(new_map.get(), std::memory_order_release);
+      m_maps.push_back(std::move(new_map));
+      return;
+    }
+
+    map->insert(key, ids, index);
+  }
+
+  std::array<ndt::type, N> signature(const T &child) const {
+    std::array<ndt::type, N> tps;
+    m_dispatch(child->get_ret_type(), child->get_narg(), child->get_arg_types().data(), tps.data());
+
+    return tps;
+  }
+
   static size_t hash_combine(size_t seed, type_id_t id) { return seed ^ (id + (seed << 6) + (seed >> 2)); }
 
   template <typename... IDTypes>
@@ -165,14 +254,14 @@ private:
   }
 
 public:
-  dispatcher(dispatch_t dispatch) : m_dispatch(dispatch) {}
+  dispatcher(dispatch_t dispatch) : m_dispatch(dispatch), m_map(nullptr) {}
 
-  dispatcher(const dispatcher &other) : m_children(other.m_children), m_dispatch(other.m_dispatch) {}
+  dispatcher(const dispatcher &other)
+      : m_children(other.m_children), m_signatures(other.m_signatures), m_dispatch(other.m_dispatch),
+        m_map(nullptr) {}
 
   template <typename Iterator>
-  dispatcher(dispatch_t dispatch, Iterator begin, Iterator end) : m_dispatch(dispatch) {
-    //    m_map.set_empty_key(uninitialized_id);
-
+  dispatcher(dispatch_t dispatch, Iterator begin, Iterator end) : m_dispatch(dispatch), m_map(nullptr) {
     assign(begin, end);
   }
 
@@ -184,22 +273,15 @@ public:
 
     std::vector<std::vector<size_t>> edges(m_children.size());
     for (size_t i = 0; i < edges.size(); ++i) {
-      const auto &f_i = begin[i];
-      std::array<ndt::type, N> tp_i =
-          as_array<N>(m_dispatch(f_i->get_ret_type(), f_i->get_narg(), f_i->get_arg_types().data()));
+      std::array<ndt::type, N> tp_i = signature(begin[i]);
 
       for (size_t j = i + 1; j < edges.size(); ++j) {
-        const auto &f_j = begin[j];
-        std::array<ndt::type, N> tp_j =
-            as_array<N>(m_dispatch(f_j->get_ret_type(), f_j->get_narg(), f_j->get_arg_types().data()));
+        std::array<ndt::type, N> tp_j = signature(begin[j]);
 
         if (ambiguous(tp_i, tp_j)) {
           bool ok = false;
           for (size_t k = 0; k < edges.size(); ++k) {
-            const auto &f_k = begin[k];
-            std::array<ndt::type, N> tp_k =
-                as_array<N>(m_dispatch(f_k->get_ret_type(), f_k->get_narg(), f_k->get_arg_types().data()));
-
+            std::array<ndt::type, N> tp_k = signature(begin[k]);
             if (supercedes(tp_k, tp_i) && supercedes(tp_k, tp_j)) {
               ok = true;
             }
@@ -225,7 +307,13 @@ public:
 
     topological_sort(begin, end, edges, m_children.begin());
 
-    //    m_map.clear();
+    m_signatures.resize(m_children.size());
+    for (size_t i = 0; i < m_children.size(); ++i) {
+      m_signatures[i] = signature(m_children[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(m_map_mutex);
+    m_map.store(nullptr, std::memory_order_release);
   }
 
   void assign(std::initializer_list<T> pairs) { assign(pairs.begin(), pairs.end()); }
@@ -251,30 +339,34 @@ public:
   const_iterator cend() const { return m_children.cend(); }
 
   const value_type &operator()(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
-    std::vector<ndt::type> vector_tps = m_dispatch(dst_tp, nsrc, src_tp);
     std::array<ndt::type, N> tps;
+    m_dispatch(dst_tp, nsrc, src_tp, tps.data());
 
+    bool builtin = true;
     std::array<type_id_t, N> ids;
     for (size_t i = 0; i < N; ++i) {
-      tps[i] = vector_tps[i];
       ids[i] = tps[i].get_id();
+      builtin &= tps[i].is_builtin();
     }
 
-    //    size_t key = hash(ids);
-
-    /*
-        const auto &it = m_map.find(key);
-        if (it != m_map.end()) {
-          return it->second;
+    size_t key = hash(ids);
+    if (builtin) {
+      const table *map = m_map.load(std::memory_order_acquire);
+      if (map != nullptr) {
+        intptr_t index = map->find(key, ids);
+        if (index != -1) {
+          return m_children[index];
         }
-    */
+      }
+    }
 
-    for (const T &child : m_children) {
-      std::array<ndt::type, N> other_tps =
-          as_array<N>(m_dispatch(child->get_ret_type(), child->get_narg(), child->get_arg_types().data()));
+    for (size_t i = 0; i < m_children.size(); ++i) {
+      if (supercedes(tps, m_signatures[i])) {
+        if (builtin) {
+          emplace(key, ids, i);
+        }
 
-      if (supercedes(tps, other_tps)) {
-        return child;
+        return m_children[i];
       }
     }
 
@@ -13,8 +13,14 @@ namespace eval {
   struct DYNDT_API eval_context {
     // Default error mode for computations
     assign_error_mode errmode;
+    // Maximum number of threads an elwise kernel may split its outermost dimension across,
+    // or the JSON parser the elements of a large array, with 1 keeping every evaluation
+    // on the calling thread
+    size_t nthreads;
+    // Minimum number of elements of the outermost dimension each thread is given
+    size_t grain_size;
 
-    eval_context() : errmode(assign_error_fractional) {}
+    eval_context() : errmode(assign_error_fractional), nthreads(1), grain_size(16384) {}
   };
 
   extern DYNDT_API eval_context default_eval_context;
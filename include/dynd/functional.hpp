@@ -161,6 +161,13 @@ namespace nd {
      */
     DYND_API callable reduction(const callable &identity, const callable &child);
 
+    /**
+     * A reduction whose partial results, when it gets split across threads, are merged
+     * with ``combiner`` instead of ``child``. This is needed when the child does not
+     * accumulate into its own argument type, as a count or a mean would.
+     */
+    DYND_API callable reduction(const callable &identity, const callable &child, const callable &combiner);
+
     DYND_API callable where(const callable &child);
 
   } // namespace dynd::nd::functional
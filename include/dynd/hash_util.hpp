@@ -0,0 +1,25 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dynd {
+
+/**
+ * The 64-bit FNV-1a hash of a byte string.
+ */
+inline uint64_t hash_bytes(const char *data, size_t size) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+} // namespace dynd
@@ -5,13 +5,50 @@
 
 #pragma once
 
+#include <istream>
+#include <vector>
+
 #include <dynd/array.hpp>
+#include <dynd/json_structural_index.hpp>
 
 namespace dynd {
 namespace ndt {
   namespace json {
 
-    DYND_API void discover(ndt::type &res, const char *begin, const char *end);
+    /**
+     * Which elements of a document that's a single array ``discover`` looks at.
+     */
+    enum discover_sample_t {
+      // All of them
+      discover_sample_all,
+      // The first ``sample_size`` of them
+      discover_sample_first,
+      // ``sample_size`` of them picked at random, all equally likely, by a generator
+      // with a fixed seed so the same document always gives the same type
+      discover_sample_random
+    };
+
+    /**
+     * Infers a type that the JSON document in [begin, end) can be parsed as.
+     *
+     * When the document is a single array, the types of its elements are discovered
+     * separately and unified, which is split among threads when ``ectx->nthreads``
+     * allows it. With a sample, only some of the elements are looked at, and the rest
+     * are assumed to fit the same type and are only checked for matching brackets.
+     * If the sampled elements don't share a type, the whole document is discovered.
+     * Any sample but ``discover_sample_all`` needs a positive ``sample_size``.
+     */
+    DYND_API void discover(ndt::type &res, const char *begin, const char *end,
+                           discover_sample_t sample = discover_sample_all, intptr_t sample_size = 0,
+                           const eval::eval_context *ectx = &eval::default_eval_context);
+
+    inline ndt::type discover(const char *begin, const char *end, discover_sample_t sample = discover_sample_all,
+                              intptr_t sample_size = 0, const eval::eval_context *ectx = &eval::default_eval_context) {
+      ndt::type res;
+      discover(res, begin, end, sample, sample_size, ectx);
+
+      return res;
+    }
 
     inline void discover(ndt::type &res, const std::string &str) { discover(res, str.data(), str.data() + str.size()); }
 
@@ -30,6 +67,92 @@ namespace nd {
 
     DYND_API array parse2(const ndt::type &tp, const std::string &str);
 
+    /**
+     * Reads newline-delimited JSON, one record per line, from a stream or a file
+     * descriptor, parsing the records a batch at a time into an array of type
+     * ``batch_size * T``. The input is read through a buffer that only grows to
+     * hold the text of a batch, and every batch is parsed into the same array, so
+     * the memory used doesn't depend on the size of the input. Blank lines are
+     * skipped.
+     *
+     * When the evaluation context allows more than one thread, the lines of a
+     * batch are split into chunks parsed on the thread pool.
+     *
+     * Example:
+     *     nd::json::ndjson_reader reader(in, ndt::type("{id: int64, name: string}"), 1024);
+     *     while (intptr_t count = reader.read()) {
+     *       // Use the first count records of reader.get_batch()
+     *     }
+     */
+    class DYND_API ndjson_reader {
+      std::istream *m_stream;
+      int m_fd;
+      ndt::type m_record_tp;
+      intptr_t m_batch_size;
+      eval::eval_context m_ectx;
+      array m_batch;
+      // The text of the current batch starts at m_batch_text in the buffer, and the text that
+      // hasn't been split into lines yet is [m_buffer_begin, m_buffer_end)
+      std::vector<char> m_buffer;
+      size_t m_batch_text;
+      size_t m_buffer_begin;
+      size_t m_buffer_end;
+      bool m_eof;
+      // The number of lines consumed so far
+      intptr_t m_line;
+
+      // A line of the current batch, as offsets from the start of its text
+      struct line_span {
+        size_t begin;
+        size_t end;
+        intptr_t line;
+      };
+      std::vector<line_span> m_lines;
+      // An index for each thread parsing lines
+      std::vector<dynd::json::structural_index> m_indexes;
+
+      void init();
+
+      size_t read_some(char *data, size_t size);
+
+      bool next_line(size_t &begin, size_t &end);
+
+      void parse_lines(size_t first, size_t last, const char *record_arrmeta, dynd::json::structural_index &index);
+
+    public:
+      ndjson_reader(std::istream &stream, const ndt::type &record_tp, intptr_t batch_size,
+                    const eval::eval_context *ectx = &eval::default_eval_context);
+
+      /**
+       * Reads from a file descriptor, which the reader doesn't close.
+       */
+      ndjson_reader(int fd, const ndt::type &record_tp, intptr_t batch_size,
+                    const eval::eval_context *ectx = &eval::default_eval_context);
+
+      /**
+       * Parses the next records into the batch, overwriting the previous ones, and
+       * returns how many there were. Only the last batch has fewer than ``batch_size``
+       * records, and the count is zero once the input is exhausted.
+       */
+      intptr_t read();
+
+      /**
+       * The array of ``batch_size`` records the batches are parsed into. Its contents
+       * are replaced by every call to ``read``, so anything that needs to outlive the
+       * batch must be copied out of it.
+       */
+      const array &get_batch() const { return m_batch; }
+
+      const ndt::type &get_record_type() const { return m_record_tp; }
+
+      intptr_t get_batch_size() const { return m_batch_size; }
+
+      /**
+       * The number of lines of the input consumed so far, including blank ones.
+       */
+      intptr_t get_line() const { return m_line; }
+    };
+
   } // namespace dynd::nd::json
 } // namespace dynd::nd
 
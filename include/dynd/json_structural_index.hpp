@@ -0,0 +1,61 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace json {
+
+  /**
+   * The positions of the structural characters of a JSON document, found in one
+   * pass over the text a block of 64 bytes at a time, before any of it is parsed.
+   *
+   * The structural characters are the brackets, braces, colons and commas that
+   * aren't inside a string, the opening quote of every string, and the first
+   * character of every other value (numbers, ``true``, ``false`` and ``null``).
+   * Every value thus starts at an indexed position, and ends before the next one,
+   * so a parser can move from value to value without looking at the bytes in between.
+   *
+   * The positions are byte offsets from the start of the document, followed by
+   * one extra position at the end of the document.
+   */
+  class DYND_API structural_index {
+    const char *m_begin;
+    const char *m_end;
+    std::vector<size_t> m_positions;
+
+  public:
+    structural_index() : m_begin(NULL), m_end(NULL), m_positions(1, 0) {}
+
+    structural_index(const char *begin, const char *end) { build(begin, end); }
+
+    /**
+     * Indexes the document in [begin, end), replacing any previous index. The
+     * document isn't copied, so it must stay alive as long as the index is used.
+     */
+    void build(const char *begin, const char *end);
+
+    const char *get_begin() const { return m_begin; }
+
+    const char *get_end() const { return m_end; }
+
+    /**
+     * The number of structural characters, not counting the final position.
+     */
+    size_t size() const { return m_positions.size() - 1; }
+
+    /**
+     * The offsets of the structural characters, of which there are ``size() + 1``
+     * including the end of the document.
+     */
+    const size_t *positions() const { return m_positions.data(); }
+  };
+
+} // namespace dynd::json
+} // namespace dynd
@@ -16,13 +16,23 @@ namespace nd {
       template <typename func_type, func_type func, typename R, typename A, typename I, typename K, typename J>
       struct apply_function_kernel;
 
+      /**
+       * Functions that take and return scalars, like the arithmetic operators, get the
+       * contiguous fast path. Everything else uses the generic strided loop.
+       */
+      template <typename SelfType, typename R, typename... A>
+      using apply_function_base = std::conditional_t<
+          std::is_same<std::integer_sequence<bool, true, is_dynd_scalar<R>::value, is_dynd_scalar<A>::value...>,
+                       std::integer_sequence<bool, is_dynd_scalar<R>::value, is_dynd_scalar<A>::value..., true>>::value,
+          base_contiguous_kernel<SelfType, R, A...>, base_strided_kernel<SelfType, sizeof...(A)>>;
+
       template <typename func_type, func_type func, typename R, typename... A, size_t... I, typename... K, size_t... J>
       struct apply_function_kernel<func_type, func, R, type_sequence<A...>, std::index_sequence<I...>,
                                    type_sequence<K...>, std::index_sequence<J...>>
-          : base_strided_kernel<
+          : apply_function_base<
                 apply_function_kernel<func_type, func, R, type_sequence<A...>, std::index_sequence<I...>,
                                       type_sequence<K...>, std::index_sequence<J...>>,
-                sizeof...(A)>,
+                R, A...>,
             apply_args<type_sequence<A...>, std::index_sequence<I...>>,
             apply_kwds<type_sequence<K...>, std::index_sequence<J...>> {
         typedef apply_args<type_sequence<A...>, std::index_sequence<I...>> args_type;
@@ -0,0 +1,191 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <dynd/kernels/sort_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    /**
+     * Sorts ``n`` unsigned keys together with their indices, with a least significant
+     * digit radix sort over bytes. Like any such sort, it is stable. ``key_buf`` and
+     * ``index_buf`` are scratch space for ``n`` values each.
+     */
+    template <typename U>
+    void radix_argsort(U *key, U *key_buf, intptr_t *index, intptr_t *index_buf, size_t n) {
+      size_t counts[sizeof(U)][256] = {};
+      for (size_t i = 0; i < n; ++i) {
+        for (size_t d = 0; d < sizeof(U); ++d) {
+          ++counts[d][(key[i] >> (8 * d)) & 0xff];
+        }
+      }
+
+      U *src_key = key, *dst_key = key_buf;
+      intptr_t *src_index = index, *dst_index = index_buf;
+      for (size_t d = 0; d < sizeof(U); ++d) {
+        size_t *count = counts[d];
+        if (count[(src_key[0] >> (8 * d)) & 0xff] == n) {
+          continue;
+        }
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; ++b) {
+          size_t c = count[b];
+          count[b] = offset;
+          offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+          size_t j = count[(src_key[i] >> (8 * d)) & 0xff]++;
+          dst_key[j] = src_key[i];
+          dst_index[j] = src_index[i];
+        }
+        std::swap(src_key, dst_key);
+        std::swap(src_index, dst_index);
+      }
+
+      if (src_index != index) {
+        std::copy(src_index, src_index + n, index);
+      }
+    }
+
+    /**
+     * Writes the ``n`` indices of ``index`` to a destination with the given stride.
+     */
+    inline void store_indices(char *dst, intptr_t dst_stride, const intptr_t *index, size_t n) {
+      if (reinterpret_cast<const char *>(index) == dst) {
+        return;
+      }
+
+      for (size_t i = 0; i < n; ++i) {
+        *reinterpret_cast<intptr_t *>(dst + i * dst_stride) = index[i];
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Computes the permutation that sorts a one-dimensional array, comparing elements
+   * with the child ``less`` kernel.
+   */
+  struct argsort_kernel : base_strided_kernel<argsort_kernel, 1> {
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const bool stable;
+
+    argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride, bool stable)
+        : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride), stable(stable) {}
+
+    ~argsort_kernel() { get_child()->destroy(); }
+
+    void single(char *dst, char *const *src) {
+      size_t n = src0_size;
+      std::vector<intptr_t> buf;
+      intptr_t *index = reinterpret_cast<intptr_t *>(dst);
+      if (dst_stride != static_cast<intptr_t>(sizeof(intptr_t))) {
+        buf.resize(n);
+        index = buf.data();
+      }
+      std::iota(index, index + n, 0);
+
+      kernel_prefix *child = get_child();
+      char *src0 = src[0];
+      intptr_t src0_stride = this->src0_stride;
+      auto less = [child, src0, src0_stride](intptr_t i, intptr_t j) {
+        bool1 res;
+        char *child_src[2] = {src0 + i * src0_stride, src0 + j * src0_stride};
+        child->single(reinterpret_cast<char *>(&res), child_src);
+        return static_cast<bool>(res);
+      };
+      if (stable) {
+        std::stable_sort(index, index + n, less);
+      } else {
+        std::sort(index, index + n, less);
+      }
+
+      detail::store_indices(dst, dst_stride, index, n);
+    }
+  };
+
+  /**
+   * Computes the permutation that sorts a one-dimensional array of builtin integers or
+   * floating point values, without calling a comparison kernel. Integer keys are radix
+   * sorted, which is always stable, and floating point keys are compared inline with
+   * NaNs last.
+   */
+  template <typename Arg0Type>
+  struct builtin_argsort_kernel : base_strided_kernel<builtin_argsort_kernel<Arg0Type>, 1> {
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const bool stable;
+
+    builtin_argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride, bool stable)
+        : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride), stable(stable) {}
+
+    template <typename T = Arg0Type>
+    typename std::enable_if<std::is_integral<T>::value>::type argsort(intptr_t *index, const char *src0, size_t n) {
+      if (n < detail::radix_sort_min_size) {
+        std::stable_sort(index, index + n, [this, src0](intptr_t i, intptr_t j) {
+          return *reinterpret_cast<const T *>(src0 + i * src0_stride) <
+                 *reinterpret_cast<const T *>(src0 + j * src0_stride);
+        });
+        return;
+      }
+
+      typedef typename std::make_unsigned<T>::type U;
+      const U sign = std::is_signed<T>::value ? static_cast<U>(U(1) << (8 * sizeof(T) - 1)) : U(0);
+
+      std::unique_ptr<U[]> key(new U[2 * n]);
+      std::unique_ptr<intptr_t[]> index_buf(new intptr_t[n]);
+      for (size_t i = 0; i < n; ++i) {
+        key[i] = static_cast<U>(*reinterpret_cast<const T *>(src0 + i * src0_stride)) ^ sign;
+      }
+      detail::radix_argsort(key.get(), key.get() + n, index, index_buf.get(), n);
+    }
+
+    template <typename T = Arg0Type>
+    typename std::enable_if<std::is_floating_point<T>::value>::type argsort(intptr_t *index, const char *src0,
+                                                                            size_t n) {
+      auto less = [this, src0](intptr_t i, intptr_t j) {
+        return detail::nan_last_less<T>()(*reinterpret_cast<const T *>(src0 + i * src0_stride),
+                                          *reinterpret_cast<const T *>(src0 + j * src0_stride));
+      };
+      if (stable) {
+        std::stable_sort(index, index + n, less);
+      } else {
+        std::sort(index, index + n, less);
+      }
+    }
+
+    void single(char *dst, char *const *src) {
+      size_t n = src0_size;
+      if (n == 0) {
+        return;
+      }
+
+      std::vector<intptr_t> buf;
+      intptr_t *index = reinterpret_cast<intptr_t *>(dst);
+      if (dst_stride != static_cast<intptr_t>(sizeof(intptr_t))) {
+        buf.resize(n);
+        index = buf.data();
+      }
+      std::iota(index, index + n, 0);
+
+      argsort(index, src[0], n);
+
+      detail::store_indices(dst, dst_stride, index, n);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -24,6 +24,7 @@
 #include <dynd/types/fixed_bytes_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/option_type.hpp>
+#include <dynd/types/scalar_kind_type.hpp>
 #include <dynd/types/type_id.hpp>
 #include <map>
 
@@ -1407,6 +1408,55 @@ namespace nd {
       }
     };
 
+    /**
+     * Encodes values as a categorical type, looking each one up in the table of its
+     * categories. A strided run is encoded in one pass. Values of another type than the
+     * category type are first converted by the child kernel, a block at a time.
+     */
+    template <>
+    struct assignment_virtual_kernel<ndt::categorical_type, ndt::scalar_kind_type>
+        : base_strided_kernel<assignment_virtual_kernel<ndt::categorical_type, ndt::scalar_kind_type>, 1> {
+      static const size_t block_size = 128;
+
+      ndt::type dst_tp;
+      const char *src0_arrmeta;
+      bool convert;
+
+      assignment_virtual_kernel(const ndt::type &dst_tp, const char *src0_arrmeta, bool convert)
+          : dst_tp(dst_tp), src0_arrmeta(src0_arrmeta), convert(convert) {}
+
+      ~assignment_virtual_kernel() {
+        if (convert) {
+          get_child()->destroy();
+        }
+      }
+
+      void single(char *dst, char *const *src) {
+        static const intptr_t src_stride[1] = {0};
+        strided(dst, 0, src, src_stride, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        const ndt::categorical_type *cat = dst_tp.extended<ndt::categorical_type>();
+        if (!convert) {
+          cat->encode(dst, dst_stride, src0_arrmeta, src[0], src_stride[0], count);
+          return;
+        }
+
+        // The category type is builtin when converting, so a value is at most 16 bytes
+        kernel_prefix *child = get_child();
+        intptr_t category_size = cat->get_category_type().get_data_size();
+        char buffer[block_size * 16];
+        char *src0 = src[0];
+        for (size_t i = 0; i < count; i += block_size) {
+          size_t n = (count - i < block_size) ? (count - i) : static_cast<size_t>(block_size);
+          child->strided(buffer, category_size, &src0, src_stride, n);
+          cat->encode(dst + i * dst_stride, dst_stride, NULL, buffer, category_size, n);
+          src0 += n * src_stride[0];
+        }
+      }
+    };
+
     template <>
     struct assignment_virtual_kernel<ndt::type, ndt::type>
         : base_strided_kernel<assignment_virtual_kernel<ndt::type, ndt::type>, 1> {
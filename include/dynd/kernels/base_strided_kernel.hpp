@@ -84,5 +84,40 @@ namespace nd {
     }
   };
 
+  /**
+   * A strided kernel over a fixed-size destination of type DstType and sources of types SrcTypes,
+   * without any state. When every operand is contiguous, the loop is run with strides known at
+   * compile time, which lets the compiler vectorize ``single`` for whatever instruction set it
+   * targets. Any other strides take the generic loop.
+   */
+  template <typename SelfType, typename DstType, typename... SrcTypes>
+  struct base_contiguous_kernel : base_strided_kernel<SelfType, sizeof...(SrcTypes)> {
+    template <size_t... I>
+    static bool is_contiguous(intptr_t dst_stride, const intptr_t *src_stride, std::index_sequence<I...>) {
+      bool res = dst_stride == static_cast<intptr_t>(sizeof(DstType));
+      for (bool src_contiguous : {true, (src_stride[I] == static_cast<intptr_t>(sizeof(SrcTypes)))...}) {
+        res = res && src_contiguous;
+      }
+
+      return res;
+    }
+
+    template <size_t... I>
+    void contiguous(char *dst, char *const *src, size_t count, std::index_sequence<I...>) {
+      for (size_t i = 0; i < count; ++i) {
+        char *src_i[sizeof...(SrcTypes)] = {(src[I] + i * sizeof(SrcTypes))...};
+        reinterpret_cast<SelfType *>(this)->single(dst + i * sizeof(DstType), src_i);
+      }
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (is_contiguous(dst_stride, src_stride, std::index_sequence_for<SrcTypes...>())) {
+        contiguous(dst, src, count, std::index_sequence_for<SrcTypes...>());
+      } else {
+        base_strided_kernel<SelfType, sizeof...(SrcTypes)>::strided(dst, dst_stride, src, src_stride, count);
+      }
+    }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
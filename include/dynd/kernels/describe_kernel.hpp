@@ -0,0 +1,158 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <limits>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    /**
+     * The running statistics of a describe reduction, read from and written back to a
+     * ``{count: int64, sum: float64, min: float64, max: float64, mean: float64, var: float64}``
+     * struct with the given field offsets. While it is loaded, the variance is carried as
+     * the sum of squared deviations from the mean, as Welford's algorithm updates it.
+     */
+    struct describe_state {
+      int64 count;
+      double sum;
+      double min;
+      double max;
+      double mean;
+      double m2;
+
+      describe_state(const char *data, const uintptr_t *offsets)
+          : count(*reinterpret_cast<const int64 *>(data + offsets[0])),
+            sum(*reinterpret_cast<const double *>(data + offsets[1])),
+            min(*reinterpret_cast<const double *>(data + offsets[2])),
+            max(*reinterpret_cast<const double *>(data + offsets[3])),
+            mean(*reinterpret_cast<const double *>(data + offsets[4])),
+            m2(*reinterpret_cast<const double *>(data + offsets[5]) * count) {}
+
+      void add(double x) {
+        ++count;
+        sum += x;
+        min = (x < min) ? x : min;
+        max = (x > max) ? x : max;
+
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+      }
+
+      /**
+       * Merges the statistics of another run of values, with the pairwise update of
+       * Chan, Golub and LeVeque.
+       */
+      void merge(const describe_state &other) {
+        if (other.count == 0) {
+          return;
+        }
+
+        if (count == 0) {
+          *this = other;
+          return;
+        }
+
+        int64 n = count + other.count;
+        double delta = other.mean - mean;
+        sum += other.sum;
+        min = (other.min < min) ? other.min : min;
+        max = (other.max > max) ? other.max : max;
+        mean += delta * other.count / n;
+        m2 += other.m2 + delta * delta * count * other.count / n;
+        count = n;
+      }
+
+      void store(char *data, const uintptr_t *offsets) const {
+        *reinterpret_cast<int64 *>(data + offsets[0]) = count;
+        *reinterpret_cast<double *>(data + offsets[1]) = sum;
+        *reinterpret_cast<double *>(data + offsets[2]) = min;
+        *reinterpret_cast<double *>(data + offsets[3]) = max;
+        *reinterpret_cast<double *>(data + offsets[4]) = mean;
+        *reinterpret_cast<double *>(data + offsets[5]) = (count == 0) ? 0.0 : (m2 / count);
+      }
+    };
+
+    static const size_t describe_nfield = 6;
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Accumulates values of type Arg0Type into describe statistics.
+   */
+  template <typename Arg0Type>
+  struct describe_kernel : base_strided_kernel<describe_kernel<Arg0Type>, 1> {
+    uintptr_t offsets[detail::describe_nfield];
+
+    describe_kernel(const uintptr_t *offsets) { memcpy(this->offsets, offsets, sizeof(this->offsets)); }
+
+    void single(char *dst, char *const *src) {
+      detail::describe_state state(dst, offsets);
+      state.add(static_cast<double>(*reinterpret_cast<Arg0Type *>(src[0])));
+      state.store(dst, offsets);
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (dst_stride != 0) {
+        base_strided_kernel<describe_kernel<Arg0Type>, 1>::strided(dst, dst_stride, src, src_stride, count);
+        return;
+      }
+
+      // Keep the statistics loaded across the run
+      detail::describe_state state(dst, offsets);
+      char *src0 = src[0];
+      intptr_t src0_stride = src_stride[0];
+      for (size_t i = 0; i < count; ++i) {
+        state.add(static_cast<double>(*reinterpret_cast<Arg0Type *>(src0)));
+        src0 += src0_stride;
+      }
+      state.store(dst, offsets);
+    }
+  };
+
+  /**
+   * Writes the statistics of no values.
+   */
+  struct describe_identity_kernel : base_strided_kernel<describe_identity_kernel, 0> {
+    uintptr_t offsets[detail::describe_nfield];
+
+    describe_identity_kernel(const uintptr_t *offsets) { memcpy(this->offsets, offsets, sizeof(this->offsets)); }
+
+    void single(char *dst, char *const *DYND_UNUSED(src)) {
+      *reinterpret_cast<int64 *>(dst + offsets[0]) = 0;
+      *reinterpret_cast<double *>(dst + offsets[1]) = 0.0;
+      *reinterpret_cast<double *>(dst + offsets[2]) = std::numeric_limits<double>::infinity();
+      *reinterpret_cast<double *>(dst + offsets[3]) = -std::numeric_limits<double>::infinity();
+      *reinterpret_cast<double *>(dst + offsets[4]) = 0.0;
+      *reinterpret_cast<double *>(dst + offsets[5]) = 0.0;
+    }
+  };
+
+  /**
+   * Merges the describe statistics of one run of values into those of another.
+   */
+  struct describe_combine_kernel : base_strided_kernel<describe_combine_kernel, 1> {
+    uintptr_t dst_offsets[detail::describe_nfield];
+    uintptr_t src0_offsets[detail::describe_nfield];
+
+    describe_combine_kernel(const uintptr_t *dst_offsets, const uintptr_t *src0_offsets) {
+      memcpy(this->dst_offsets, dst_offsets, sizeof(this->dst_offsets));
+      memcpy(this->src0_offsets, src0_offsets, sizeof(this->src0_offsets));
+    }
+
+    void single(char *dst, char *const *src) {
+      detail::describe_state state(dst, dst_offsets);
+      state.merge(detail::describe_state(src[0], src0_offsets));
+      state.store(dst, dst_offsets);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
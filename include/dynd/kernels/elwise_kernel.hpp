@@ -7,6 +7,7 @@
 
 #include <dynd/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
@@ -30,15 +31,51 @@ namespace nd {
 
       intptr_t m_size;
       intptr_t m_dst_stride, m_src_stride[N];
+      // Copies of the child kernel for the threads other than the calling one, which
+      // are only built when the outermost dimension gets split across threads
+      kernel_builder **m_workers;
+      size_t m_nworkers;
+      size_t m_nchunks;
 
       elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *src_stride)
-          : TraitsType(data), m_size(size), m_dst_stride(dst_stride) {
+          : TraitsType(data), m_size(size), m_dst_stride(dst_stride), m_workers(NULL), m_nworkers(0), m_nchunks(0) {
         memcpy(m_src_stride, src_stride, sizeof(m_src_stride));
       }
 
-      ~elwise_kernel() { this->get_child()->destroy(); }
+      ~elwise_kernel() {
+        this->get_child()->destroy();
+        for (size_t i = 0; i < m_nworkers; ++i) {
+          delete m_workers[i];
+        }
+        delete[] m_workers;
+      }
+
+      /**
+       * Takes ownership of the per-thread child kernels, splitting the dimension into
+       * ``nchunks`` pieces that are shared out among ``nworkers + 1`` threads.
+       */
+      void set_workers(kernel_builder **workers, size_t nworkers, size_t nchunks) {
+        m_workers = workers;
+        m_nworkers = nworkers;
+        m_nchunks = nchunks;
+      }
 
       void single(char *dst, char *const *src) {
+        if (m_workers != NULL) {
+          thread_pool::get().run(m_nworkers + 1, m_nchunks, [this, dst, src](size_t chunk, size_t thread) {
+            kernel_prefix *child = (thread == 0) ? this->get_child() : m_workers[thread - 1]->get();
+            kernel_strided_t opchild = child->get_function<kernel_strided_t>();
+
+            intptr_t begin = m_size * chunk / m_nchunks, end = m_size * (chunk + 1) / m_nchunks;
+            char *chunk_src[N];
+            for (size_t i = 0; i < N; ++i) {
+              chunk_src[i] = src[i] + begin * m_src_stride[i];
+            }
+            opchild(child, dst + begin * m_dst_stride, m_dst_stride, chunk_src, m_src_stride, end - begin);
+          });
+          return;
+        }
+
         kernel_prefix *child = this->get_child();
         kernel_strided_t opchild = child->get_function<kernel_strided_t>();
 
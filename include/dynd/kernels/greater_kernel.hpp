@@ -13,7 +13,7 @@ namespace dynd {
 namespace nd {
 
   template <typename Arg0Type, typename Arg1Type>
-  struct greater_kernel : base_strided_kernel<greater_kernel<Arg0Type, Arg1Type>, 2> {
+  struct greater_kernel : base_contiguous_kernel<greater_kernel<Arg0Type, Arg1Type>, bool1, Arg0Type, Arg1Type> {
     typedef typename std::common_type<Arg0Type, Arg1Type>::type T;
 
     void single(char *dst, char *const *src) {
@@ -23,7 +23,8 @@ namespace nd {
   };
 
   template <typename Arg0Type>
-  struct greater_kernel<Arg0Type, Arg0Type> : base_strided_kernel<greater_kernel<Arg0Type, Arg0Type>, 2> {
+  struct greater_kernel<Arg0Type, Arg0Type>
+      : base_contiguous_kernel<greater_kernel<Arg0Type, Arg0Type>, bool1, Arg0Type, Arg0Type> {
     void single(char *dst, char *const *src) {
       *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<Arg0Type *>(src[0]) > *reinterpret_cast<Arg0Type *>(src[1]);
     }
@@ -21,12 +21,16 @@ namespace nd {
    * The data placed in the kernel's data must
    * be relocatable with a memcpy, it must not rely on its
    * own address.
+   *
+   * A kernel that outgrows the inline storage is moved to the heap, or to the arena
+   * given on construction, which must outlive the kernel.
    */
   class kernel_builder : public storagebuf<kernel_prefix, kernel_builder> {
     call_node *m_call;
 
   public:
-    kernel_builder(call_node *call = nullptr) : m_call(call) {}
+    kernel_builder(call_node *call = nullptr, arena *a = nullptr)
+        : storagebuf<kernel_prefix, kernel_builder>(a), m_call(call) {}
 
     DYND_API void destroy();
 
@@ -41,6 +45,11 @@ namespace nd {
 
     void emplace_back(size_t size) { storagebuf<kernel_prefix, kernel_builder>::emplace_back(size); }
 
+    /**
+     * The call node that the next kernel will be instantiated from.
+     */
+    call_node *get_call() const { return m_call; }
+
     void pass() { m_call = reinterpret_cast<call_node *>(reinterpret_cast<char *>(m_call) + m_call->data_size); }
 
     void operator()(kernel_request_t kr, char *data, const char *res_metadata, size_t narg,
@@ -11,7 +11,7 @@ namespace dynd {
 namespace nd {
 
   template <typename Arg0Type, typename Arg1Type>
-  struct less_kernel : base_strided_kernel<less_kernel<Arg0Type, Arg1Type>, 2> {
+  struct less_kernel : base_contiguous_kernel<less_kernel<Arg0Type, Arg1Type>, bool1, Arg0Type, Arg1Type> {
     typedef typename std::common_type<Arg0Type, Arg1Type>::type common_type;
 
     void single(char *dst, char *const *src) {
@@ -21,7 +21,8 @@ namespace nd {
   };
 
   template <typename Arg0Type>
-  struct less_kernel<Arg0Type, Arg0Type> : base_strided_kernel<less_kernel<Arg0Type, Arg0Type>, 2> {
+  struct less_kernel<Arg0Type, Arg0Type>
+      : base_contiguous_kernel<less_kernel<Arg0Type, Arg0Type>, bool1, Arg0Type, Arg0Type> {
     void single(char *dst, char *const *src) {
       *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<Arg0Type *>(src[0]) < *reinterpret_cast<Arg0Type *>(src[1]);
     }
@@ -0,0 +1,38 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    /**
+     * Counts the nonzero bytes of a contiguous mask, eight at a time.
+     */
+    inline size_t count_mask(const char *mask, size_t n) {
+      const uint64_t low = 0x7f7f7f7f7f7f7f7fULL, ones = 0x0101010101010101ULL;
+      size_t count = 0, i = 0;
+      for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        memcpy(&word, mask + i, 8);
+        // Sets the high bit of each nonzero byte, then sums those bits into the top byte
+        word = (((word & low) + low) | word) & ~low;
+        count += static_cast<size_t>(((word >> 7) * ones) >> 56);
+      }
+      for (; i < n; ++i) {
+        count += mask[i] != 0;
+      }
+
+      return count;
+    }
+
+  } // namespace dynd::nd::detail
+} // namespace dynd::nd
+} // namespace dynd
@@ -19,6 +19,11 @@ namespace nd {
 
     mean_kernel(int64 count) : count(count) {}
 
+    ~mean_kernel() {
+      get_child()->destroy();
+      get_child(compound_div_offset)->destroy();
+    }
+
     void single(char *dst, char *const *src)
     {
       kernel_prefix *sum_kernel = get_child();
@@ -25,6 +25,17 @@ namespace nd {
 
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
+      if (dst_stride == 0 && src0_stride == static_cast<intptr_t>(sizeof(Arg0Type))) {
+        // Scanning a contiguous run keeps the running minimum in a register
+        const Arg0Type *src0_data = reinterpret_cast<const Arg0Type *>(src0);
+        dst_type res = *reinterpret_cast<dst_type *>(dst);
+        for (size_t i = 0; i < count; ++i) {
+          res = src0_data[i] < res ? src0_data[i] : res;
+        }
+        *reinterpret_cast<dst_type *>(dst) = res;
+        return;
+      }
+
       for (size_t i = 0; i < count; ++i) {
         if (*reinterpret_cast<Arg0Type *>(src0) < *reinterpret_cast<dst_type *>(dst)) {
           *reinterpret_cast<dst_type *>(dst) = *reinterpret_cast<Arg0Type *>(src0);
@@ -6,13 +6,14 @@
 #pragma once
 
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/base_strided_kernel.hpp>
 #include <dynd/types/callable_type.hpp>
 
 namespace dynd {
 namespace nd {
 
   template <typename Arg0Type, typename Arg1Type>
-  struct not_equal_kernel : base_strided_kernel<not_equal_kernel<Arg0Type, Arg1Type>, 2> {
+  struct not_equal_kernel : base_contiguous_kernel<not_equal_kernel<Arg0Type, Arg1Type>, bool1, Arg0Type, Arg1Type> {
     typedef typename std::common_type<Arg0Type, Arg1Type>::type T;
 
     void single(char *dst, char *const *src) {
@@ -22,7 +23,8 @@ namespace nd {
   };
 
   template <typename Arg0Type>
-  struct not_equal_kernel<Arg0Type, Arg0Type> : base_strided_kernel<not_equal_kernel<Arg0Type, Arg0Type>, 2> {
+  struct not_equal_kernel<Arg0Type, Arg0Type>
+      : base_contiguous_kernel<not_equal_kernel<Arg0Type, Arg0Type>, bool1, Arg0Type, Arg0Type> {
     void single(char *res, char *const *args) {
       *reinterpret_cast<bool1 *>(res) =
           *reinterpret_cast<Arg0Type *>(args[0]) != *reinterpret_cast<Arg0Type *>(args[1]);
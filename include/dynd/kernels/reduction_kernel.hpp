@@ -5,17 +5,81 @@
 
 #pragma once
 
+#include <memory>
+
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/constant_kernel.hpp>
 #include <dynd/kernels/reduction_kernel_prefix.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
   namespace functional {
 
+    /**
+     * Passed down through the kernels of a full reduction, so that the innermost one
+     * can report back how partial results of the reduction are merged.
+     */
+    struct reduction_partials {
+      // The size of one partial result
+      size_t data_size;
+      // The offset of the kernel that merges partial results, or -1 if they can't be merged
+      intptr_t combine_offset;
+
+      reduction_partials() : data_size(0), combine_offset(-1) {}
+    };
+
+    /**
+     * Lets the outermost kernel of a full reduction split its dimension into chunks
+     * that get reduced on separate threads, each into its own partial result. The
+     * threads other than the calling one use their own copies of the child kernel.
+     */
+    struct reduction_workers {
+      kernel_builder **workers;
+      size_t nworkers;
+      size_t nchunks;
+      size_t data_size;
+      intptr_t combine_offset;
+
+      reduction_workers() : workers(NULL), nworkers(0), nchunks(0), data_size(0), combine_offset(0) {}
+
+      ~reduction_workers() {
+        for (size_t i = 0; i < nworkers; ++i) {
+          delete workers[i];
+        }
+        delete[] workers;
+      }
+
+      void set(kernel_builder **workers, size_t nworkers, size_t nchunks, size_t data_size, intptr_t combine_offset) {
+        this->workers = workers;
+        this->nworkers = nworkers;
+        this->nchunks = nchunks;
+        this->data_size = data_size;
+        this->combine_offset = combine_offset;
+      }
+
+      /**
+       * Calls ``reduce(child, partial, begin, end)`` for every chunk of [0, size), then merges
+       * the partial results into ``dst`` in order with the ``combiner`` kernel.
+       */
+      template <typename ReduceType>
+      void run(kernel_prefix *child, kernel_prefix *combiner, size_t size, char *dst, const ReduceType &reduce) {
+        std::unique_ptr<char[]> partials(new char[nchunks * data_size]);
+        thread_pool::get().run(nworkers + 1, nchunks, [&](size_t chunk, size_t thread) {
+          reduce((thread == 0) ? child : workers[thread - 1]->get(), partials.get() + chunk * data_size,
+                 size * chunk / nchunks, size * (chunk + 1) / nchunks);
+        });
+
+        memcpy(dst, partials.get(), data_size);
+        char *src = partials.get() + data_size;
+        intptr_t src_stride = data_size;
+        combiner->strided(dst, 0, &src, &src_stride, nchunks - 1);
+      }
+    };
+
     template <typename SelfType, size_t NArg>
     struct base_reduction_kernel : reduction_kernel_prefix {
       /**
@@ -114,6 +178,7 @@ namespace nd {
         : base_reduction_kernel<reduction_kernel<ndt::fixed_dim_type, false, false, NArg>, NArg> {
       intptr_t src0_element_size;
       intptr_t src_element_stride[NArg];
+      reduction_workers parallel;
 
       reduction_kernel(std::intptr_t src0_element_size, const char *const *src_arrmeta)
           : src0_element_size(src0_element_size) {
@@ -125,6 +190,27 @@ namespace nd {
       ~reduction_kernel() { this->get_child()->destroy(); }
 
       void single_first(char *dst, char *const *src) {
+        if (parallel.workers != NULL) {
+          parallel.run(this->get_child(), this->get_child(parallel.combine_offset), src0_element_size, dst,
+                       [this, src](kernel_prefix *child, char *partial, intptr_t begin, intptr_t end) {
+                         char *child_src[NArg];
+                         for (size_t j = 0; j < NArg; ++j) {
+                           child_src[j] = src[j] + begin * src_element_stride[j];
+                         }
+
+                         reduction_kernel_prefix *reduction_child = reinterpret_cast<reduction_kernel_prefix *>(child);
+                         reduction_child->single_first(partial, child_src);
+                         if (end - begin > 1) {
+                           for (size_t j = 0; j < NArg; ++j) {
+                             child_src[j] += src_element_stride[j];
+                           }
+                           reduction_child->strided_followup(partial, 0, child_src, src_element_stride,
+                                                             end - begin - 1);
+                         }
+                       });
+          return;
+        }
+
         reduction_kernel_prefix *child = this->get_reduction_child();
         // The first call at the "dst" address
         child->single_first(dst, src);
@@ -229,13 +315,35 @@ namespace nd {
       intptr_t _size;
       intptr_t src_stride[NArg];
       size_t init_offset;
+      // The kernel merging partial results of a full reduction, or 0 if there is none
+      intptr_t combine_offset;
+      reduction_workers parallel;
 
       ~reduction_kernel() {
         this->get_child()->destroy();
         this->get_child(init_offset)->destroy();
+        if (combine_offset != 0) {
+          this->get_child(combine_offset)->destroy();
+        }
       }
 
       void single_first(char *dst, char *const *src) {
+        if (parallel.workers != NULL) {
+          kernel_prefix *init_child = this->get_child(init_offset);
+          parallel.run(this->get_child(), this->get_child(parallel.combine_offset), _size, dst,
+                       [this, init_child, src](kernel_prefix *child, char *partial, intptr_t begin, intptr_t end) {
+                         // The identity is shared, as all it does is write a value
+                         init_child->single(partial, src);
+
+                         char *child_src[NArg];
+                         for (size_t j = 0; j < NArg; ++j) {
+                           child_src[j] = src[j] + begin * this->src_stride[j];
+                         }
+                         child->strided(partial, 0, child_src, this->src_stride, end - begin);
+                       });
+          return;
+        }
+
         char *child_src[NArg];
         for (size_t i = 0; i < NArg; ++i) {
           child_src[i] = src[i];
@@ -324,12 +432,17 @@ namespace nd {
         : base_reduction_kernel<reduction_kernel<ndt::var_dim_type, false, true, NArg>, NArg> {
       intptr_t src0_inner_stride;
       intptr_t init_offset;
+      // The kernel merging partial results of a full reduction, or 0 if there is none
+      intptr_t combine_offset;
 
-      reduction_kernel(std::intptr_t src0_inner_stride) : src0_inner_stride(src0_inner_stride) {}
+      reduction_kernel(std::intptr_t src0_inner_stride) : src0_inner_stride(src0_inner_stride), combine_offset(0) {}
 
       ~reduction_kernel() {
         this->get_child(init_offset)->destroy();
         this->get_child()->destroy();
+        if (combine_offset != 0) {
+          this->get_child(combine_offset)->destroy();
+        }
       }
 
       void single_first(char *dst, char *const *src) {
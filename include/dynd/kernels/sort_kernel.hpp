@@ -5,11 +5,139 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
 #include <dynd/bytes.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    // Runs shorter than this are sorted with a comparison sort instead of a radix sort
+    static const size_t radix_sort_min_size = 256;
+
+    /**
+     * Orders floating point values with NaNs after everything else, which is where a
+     * sort places them.
+     */
+    template <typename T>
+    struct nan_last_less {
+      bool operator()(T lhs, T rhs) const { return lhs < rhs || (!std::isnan(lhs) && std::isnan(rhs)); }
+    };
+
+    /**
+     * Sorts ``n`` integers with a least significant digit radix sort over bytes, using
+     * ``buf`` for ``n`` values of scratch space. The keys are compared as unsigned with
+     * the sign bit flipped, and a byte that is the same in every key costs no pass.
+     */
+    template <typename T>
+    void radix_sort(T *data, T *buf, size_t n) {
+      typedef typename std::make_unsigned<T>::type U;
+      const U sign = std::is_signed<T>::value ? static_cast<U>(U(1) << (8 * sizeof(T) - 1)) : U(0);
+
+      size_t counts[sizeof(T)][256] = {};
+      for (size_t i = 0; i < n; ++i) {
+        U key = static_cast<U>(data[i]) ^ sign;
+        for (size_t d = 0; d < sizeof(T); ++d) {
+          ++counts[d][(key >> (8 * d)) & 0xff];
+        }
+      }
+
+      T *src = data, *dst = buf;
+      for (size_t d = 0; d < sizeof(T); ++d) {
+        size_t *count = counts[d];
+        U key0 = static_cast<U>(src[0]) ^ sign;
+        if (count[(key0 >> (8 * d)) & 0xff] == n) {
+          continue;
+        }
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; ++b) {
+          size_t c = count[b];
+          count[b] = offset;
+          offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+          U key = static_cast<U>(src[i]) ^ sign;
+          dst[count[(key >> (8 * d)) & 0xff]++] = src[i];
+        }
+        std::swap(src, dst);
+      }
+
+      if (src != data) {
+        std::copy(src, src + n, data);
+      }
+    }
+
+    /**
+     * Sorts a contiguous run of ``n`` values on the calling thread, using ``buf`` for
+     * ``n`` values of scratch space.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type sort_run(T *data, T *buf, size_t n) {
+      if (n < radix_sort_min_size) {
+        std::sort(data, data + n);
+      } else {
+        radix_sort(data, buf, n);
+      }
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type sort_run(T *data, T *DYND_UNUSED(buf),
+                                                                             size_t n) {
+      // Moving the NaNs out of the way leaves a range that a plain comparison orders
+      T *end = std::partition(data, data + n, [](T x) { return !std::isnan(x); });
+      std::sort(data, end);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, std::less<T>>::type sort_less() {
+      return std::less<T>();
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, nan_last_less<T>>::type sort_less() {
+      return nan_last_less<T>();
+    }
+
+    /**
+     * Sorts ``n`` contiguous values by sorting ``nchunks`` chunks of them concurrently,
+     * then merging neighbouring runs in rounds, each of which merges its pairs of runs
+     * concurrently and doubles the length of the runs.
+     */
+    template <typename T>
+    void parallel_sort(T *data, T *buf, size_t n, size_t nthreads, size_t nchunks) {
+      thread_pool &pool = thread_pool::get();
+      pool.run(nthreads, nchunks, [=](size_t chunk, size_t DYND_UNUSED(thread)) {
+        size_t begin = n * chunk / nchunks, end = n * (chunk + 1) / nchunks;
+        sort_run(data + begin, buf + begin, end - begin);
+      });
+
+      T *src = data, *dst = buf;
+      for (size_t width = 1; width < nchunks; width *= 2) {
+        size_t npairs = (nchunks + 2 * width - 1) / (2 * width);
+        pool.run(nthreads, npairs, [=](size_t pair, size_t DYND_UNUSED(thread)) {
+          size_t begin = n * std::min(2 * pair * width, nchunks) / nchunks;
+          size_t middle = n * std::min((2 * pair + 1) * width, nchunks) / nchunks;
+          size_t end = n * std::min((2 * pair + 2) * width, nchunks) / nchunks;
+          std::merge(src + begin, src + middle, src + middle, src + end, dst + begin, sort_less<T>());
+        });
+        std::swap(src, dst);
+      }
+
+      if (src != data) {
+        std::copy(src, src + n, data);
+      }
+    }
+
+  } // namespace dynd::nd::detail
 
   struct sort_kernel : base_strided_kernel<sort_kernel, 1> {
     const intptr_t src0_size;
@@ -37,5 +165,70 @@ namespace nd {
     }
   };
 
+  /**
+   * Sorts a one-dimensional array of builtin integers or floating point values in place,
+   * without calling a comparison kernel. Integers are radix sorted and floating point
+   * values are sorted with NaNs last. A strided array is sorted through a contiguous
+   * copy, and a large array is split across the thread pool and merged.
+   */
+  template <typename Arg0Type>
+  struct builtin_sort_kernel : base_strided_kernel<builtin_sort_kernel<Arg0Type>, 1> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    builtin_sort_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    /**
+     * The number of threads a sort of ``n`` values is split across, where 1 keeps it serial.
+     */
+    static size_t get_nthreads(size_t n) {
+      // Checked first so that a serial sort never starts the thread pool
+      if (eval::default_eval_context.nthreads <= 1 || thread_pool::in_task()) {
+        return 1;
+      }
+
+      size_t grain_size = std::max<size_t>(eval::default_eval_context.grain_size, 1);
+      return std::max<size_t>(
+          std::min(std::min(eval::default_eval_context.nthreads, thread_pool::get().get_nthreads()), n / grain_size),
+          1);
+    }
+
+    void single(char *DYND_UNUSED(dst), char *const *src) {
+      size_t n = src0_size;
+      if (n < 2) {
+        return;
+      }
+
+      std::unique_ptr<Arg0Type[]> copy;
+      Arg0Type *data = reinterpret_cast<Arg0Type *>(src[0]);
+      if (src0_stride != static_cast<intptr_t>(sizeof(Arg0Type))) {
+        copy.reset(new Arg0Type[n]);
+        for (size_t i = 0; i < n; ++i) {
+          copy[i] = *reinterpret_cast<Arg0Type *>(src[0] + i * src0_stride);
+        }
+        data = copy.get();
+      }
+
+      // Only a radix sort and the merges of a parallel sort use scratch space
+      size_t nthreads = get_nthreads(n);
+      std::unique_ptr<Arg0Type[]> buf;
+      if (nthreads > 1 || (std::is_integral<Arg0Type>::value && n >= detail::radix_sort_min_size)) {
+        buf.reset(new Arg0Type[n]);
+      }
+
+      if (nthreads > 1) {
+        detail::parallel_sort(data, buf.get(), n, nthreads, nthreads);
+      } else {
+        detail::sort_run(data, buf.get(), n);
+      }
+
+      if (copy) {
+        for (size_t i = 0; i < n; ++i) {
+          *reinterpret_cast<Arg0Type *>(src[0] + i * src0_stride) = copy[i];
+        }
+      }
+    }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
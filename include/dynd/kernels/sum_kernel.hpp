@@ -9,11 +9,97 @@
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    // The number of independent accumulators in a block of a pairwise sum
+    static const size_t pairwise_nacc = 8;
+
+    // The largest run that a pairwise sum adds as a single block
+    static const size_t pairwise_block_size = 128;
+
+    /**
+     * Sums ``count > 0`` values, splitting the run in half until it fits in a block. Each
+     * block is added into independent accumulators, which breaks the dependency between
+     * consecutive additions, and the rounding error grows with the logarithm of ``count``
+     * instead of linearly. The stride may be an ``std::integral_constant``, making it known
+     * at compile time.
+     */
+    template <typename T, typename StrideType>
+    T pairwise_sum(const char *src, StrideType stride, size_t count) {
+      if (count < pairwise_nacc) {
+        T res = *reinterpret_cast<const T *>(src);
+        for (size_t i = 1; i < count; ++i) {
+          res = res + *reinterpret_cast<const T *>(src + i * stride);
+        }
+        return res;
+      }
+
+      if (count <= pairwise_block_size) {
+        T acc[pairwise_nacc];
+        for (size_t j = 0; j < pairwise_nacc; ++j) {
+          acc[j] = *reinterpret_cast<const T *>(src + j * stride);
+        }
+
+        size_t i = pairwise_nacc;
+        for (; i + pairwise_nacc <= count; i += pairwise_nacc) {
+          for (size_t j = 0; j < pairwise_nacc; ++j) {
+            acc[j] = acc[j] + *reinterpret_cast<const T *>(src + (i + j) * stride);
+          }
+        }
+
+        T res = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+        for (; i < count; ++i) {
+          res = res + *reinterpret_cast<const T *>(src + i * stride);
+        }
+        return res;
+      }
+
+      size_t half = count / 2;
+      half -= half % pairwise_nacc;
+      return pairwise_sum<T>(src, stride, half) + pairwise_sum<T>(src + half * stride, stride, count - half);
+    }
+
+    // The type a compensated sum is carried out in, which needs subtraction
+    template <typename T>
+    struct compensated_type {
+      typedef T type;
+    };
+
+    template <>
+    struct compensated_type<float16> {
+      typedef float type;
+    };
+
+    /**
+     * Adds ``count`` values to ``res`` in order, with Kahan's compensation for the
+     * rounding error of each addition.
+     */
+    template <typename T>
+    T kahan_sum(T res, const char *src, intptr_t stride, size_t count) {
+      typedef typename compensated_type<T>::type U;
+
+      U sum = static_cast<U>(res);
+      U c = static_cast<U>(0);
+      for (size_t i = 0; i < count; ++i) {
+        U y = static_cast<U>(*reinterpret_cast<const T *>(src + i * stride)) - c;
+        U t = sum + y;
+        c = (t - sum) - y;
+        sum = t;
+      }
+
+      return static_cast<T>(sum);
+    }
+
+  } // namespace dynd::nd::detail
 
   template <typename Arg0Type>
   struct sum_kernel : base_strided_kernel<sum_kernel<Arg0Type>, 1> {
     typedef Arg0Type dst_type;
 
+    summation_mode mode;
+
+    sum_kernel(summation_mode mode = summation_pairwise) : mode(mode) {}
+
     void single(char *dst, char *const *src) {
       *reinterpret_cast<dst_type *>(dst) = *reinterpret_cast<dst_type *>(dst) + *reinterpret_cast<Arg0Type *>(src[0]);
     }
@@ -21,6 +107,40 @@ namespace nd {
     void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
+      if (dst_stride == 0 && count != 0 && mode != summation_serial) {
+        dst_type &res = *reinterpret_cast<dst_type *>(dst);
+        if (mode == summation_kahan) {
+          res = detail::kahan_sum<Arg0Type>(res, src0, src0_stride, count);
+        } else if (src0_stride == static_cast<intptr_t>(sizeof(Arg0Type))) {
+          res = res + detail::pairwise_sum<Arg0Type>(
+                          src0, std::integral_constant<intptr_t, sizeof(Arg0Type)>(), count);
+        } else {
+          res = res + detail::pairwise_sum<Arg0Type>(src0, src0_stride, count);
+        }
+        return;
+      }
+
+      if (src0_stride == static_cast<intptr_t>(sizeof(Arg0Type))) {
+        const Arg0Type *src0_data = reinterpret_cast<const Arg0Type *>(src0);
+        if (dst_stride == 0) {
+          // Accumulating a contiguous run into one value keeps the partial sum in a register
+          dst_type res = *reinterpret_cast<dst_type *>(dst);
+          for (size_t i = 0; i < count; ++i) {
+            res = res + src0_data[i];
+          }
+          *reinterpret_cast<dst_type *>(dst) = res;
+          return;
+        }
+
+        if (dst_stride == static_cast<intptr_t>(sizeof(dst_type))) {
+          dst_type *dst_data = reinterpret_cast<dst_type *>(dst);
+          for (size_t i = 0; i < count; ++i) {
+            dst_data[i] = dst_data[i] + src0_data[i];
+          }
+          return;
+        }
+      }
+
       for (size_t i = 0; i < count; ++i) {
         *reinterpret_cast<dst_type *>(dst) = *reinterpret_cast<dst_type *>(dst) + *reinterpret_cast<Arg0Type *>(src0);
         dst += dst_stride;
@@ -29,5 +149,13 @@ namespace nd {
     }
   };
 
+  /**
+   * Writes the additive identity of T, which a sum starts from.
+   */
+  template <typename T>
+  struct sum_identity_kernel : base_strided_kernel<sum_identity_kernel<T>, 0> {
+    void single(char *dst, char *const *DYND_UNUSED(src)) { *reinterpret_cast<T *>(dst) = static_cast<T>(0); }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
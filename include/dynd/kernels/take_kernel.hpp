@@ -5,33 +5,119 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+
 #include <dynd/shape_tools.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/mask_util.hpp>
 #include <dynd/assignment.hpp>
 
 namespace dynd {
 namespace nd {
 
+  namespace detail {
+
+    /**
+     * Copies the elements of a contiguous array of ``N``-byte elements whose mask byte is
+     * nonzero to the contiguous ``dst``, which has room for exactly ``count`` of them. Eight
+     * mask bytes are examined at a time, so runs of unselected or selected elements are
+     * skipped or copied whole, and the rest are copied without branching on the mask.
+     */
+    template <size_t N>
+    void compress(char *dst, const char *src, const char *mask, size_t count) {
+      const uint64_t ones = 0x0101010101010101ULL;
+      size_t i = 0, j = 0;
+      while (j < count) {
+        if (j + 8 <= count) {
+          uint64_t word;
+          memcpy(&word, mask + i, 8);
+          if (word == 0) {
+            i += 8;
+            continue;
+          }
+          if (word == ones) {
+            memcpy(dst + j * N, src + i * N, 8 * N);
+            i += 8;
+            j += 8;
+            continue;
+          }
+        }
+
+        // Writing before checking the mask stays in bounds, as the loop ends once
+        // every selected element has been copied
+        size_t stop = i + 8;
+        for (; i < stop && j < count; ++i) {
+          memcpy(dst + j * N, src + i * N, N);
+          j += mask[i] != 0;
+        }
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
   struct DYND_API masked_take_ck : base_strided_kernel<masked_take_ck, 2> {
     const char *m_dst_meta;
     intptr_t m_dim_size, m_src0_stride, m_mask_stride;
+    // The size of the elements when they are builtin and can be copied directly, or 0
+    intptr_t m_element_size;
 
     ~masked_take_ck() { get_child()->destroy(); }
 
+    // Copies the selected elements directly, returning false if their layout doesn't allow it
+    bool compress(char *dst, intptr_t dst_stride, const char *src0, const char *mask, size_t count) {
+      if (m_element_size == 0 || m_mask_stride != 1 || m_src0_stride != m_element_size ||
+          dst_stride != m_element_size) {
+        return false;
+      }
+
+      switch (m_element_size) {
+      case 1:
+        detail::compress<1>(dst, src0, mask, count);
+        return true;
+      case 2:
+        detail::compress<2>(dst, src0, mask, count);
+        return true;
+      case 4:
+        detail::compress<4>(dst, src0, mask, count);
+        return true;
+      case 8:
+        detail::compress<8>(dst, src0, mask, count);
+        return true;
+      case 16:
+        detail::compress<16>(dst, src0, mask, count);
+        return true;
+      default:
+        return false;
+      }
+    }
+
     void single(char *dst, char *const *src) {
       kernel_prefix *child = get_child();
       kernel_strided_t child_fn = child->get_function<kernel_strided_t>();
       char *src0 = src[0];
       char *mask = src[1];
       intptr_t dim_size = m_dim_size, src0_stride = m_src0_stride, mask_stride = m_mask_stride;
-      // Start with the dst matching the dim size. (Maybe better to
-      // do smaller? This means no resize required in the loop.)
+
+      // Count the selection first, so the dst is allocated once at its final size
+      intptr_t dst_count = 0;
+      if (mask_stride == 1) {
+        dst_count = detail::count_mask(mask, dim_size);
+      } else {
+        for (intptr_t i = 0; i < dim_size; ++i) {
+          dst_count += mask[i * mask_stride] != 0;
+        }
+      }
+
       ndt::var_dim_type::data_type *vdd = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
-      vdd->begin = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta)->blockref->alloc(dim_size);
-      vdd->size = dim_size;
+      vdd->begin = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta)->blockref->alloc(dst_count);
+      vdd->size = dst_count;
       char *dst_ptr = vdd->begin;
       intptr_t dst_stride = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta)->stride;
-      intptr_t dst_count = 0;
+      if (compress(dst_ptr, dst_stride, src0, mask, dst_count)) {
+        return;
+      }
+
       intptr_t i = 0;
       while (i < dim_size) {
         // Run of false
@@ -47,16 +133,71 @@ namespace nd {
           child_fn(child, dst_ptr, dst_stride, &src0, &src0_stride, run_count);
           dst_ptr += run_count * dst_stride;
           src0 += run_count * src0_stride;
-          dst_count += run_count;
         }
       }
-
-      vdd->begin = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta)
-                       ->blockref->resize(vdd->begin, dst_count);
-      vdd->size = dst_count;
     }
   };
 
+  namespace detail {
+
+    // How many indices ahead of the current one a gather prefetches the element of
+    static const intptr_t take_prefetch_distance = 16;
+
+    /**
+     * Checks every index of an indexed take against a dimension of size ``dim_size``,
+     * allowing Python-style negative indices. The smallest and largest indices are
+     * found in one pass, so only an invalid index array is examined element by element.
+     */
+    inline void check_indices(const char *index, intptr_t index_stride, intptr_t count, intptr_t dim_size) {
+      intptr_t lo = 0, hi = 0;
+      if (index_stride == static_cast<intptr_t>(sizeof(intptr_t))) {
+        const intptr_t *contiguous_index = reinterpret_cast<const intptr_t *>(index);
+        for (intptr_t i = 0; i < count; ++i) {
+          lo = std::min(lo, contiguous_index[i]);
+          hi = std::max(hi, contiguous_index[i]);
+        }
+      } else {
+        for (intptr_t i = 0; i < count; ++i) {
+          intptr_t ix = *reinterpret_cast<const intptr_t *>(index + i * index_stride);
+          lo = std::min(lo, ix);
+          hi = std::max(hi, ix);
+        }
+      }
+
+      if (count > 0 && (lo < -dim_size || hi >= dim_size)) {
+        // Raise the error for the first index that is out of bounds
+        for (intptr_t i = 0; i < count; ++i) {
+          apply_single_index(*reinterpret_cast<const intptr_t *>(index + i * index_stride), dim_size, NULL);
+        }
+      }
+    }
+
+    /**
+     * Copies the ``N``-byte elements of ``src0`` at a sequence of checked indices to ``dst``,
+     * prefetching the element a fixed distance ahead of the one being copied.
+     */
+    template <size_t N>
+    void gather(char *dst, intptr_t dst_stride, const char *src0, intptr_t src0_dim_size, intptr_t src0_stride,
+                const char *index, intptr_t index_stride, intptr_t count) {
+      intptr_t i = 0;
+      for (; i < count - take_prefetch_distance; ++i) {
+        intptr_t ahead = *reinterpret_cast<const intptr_t *>(index + (i + take_prefetch_distance) * index_stride);
+        ahead += (ahead < 0) ? src0_dim_size : 0;
+        DYND_PREFETCH(src0 + ahead * src0_stride);
+
+        intptr_t ix = *reinterpret_cast<const intptr_t *>(index + i * index_stride);
+        ix += (ix < 0) ? src0_dim_size : 0;
+        memcpy(dst + i * dst_stride, src0 + ix * src0_stride, N);
+      }
+      for (; i < count; ++i) {
+        intptr_t ix = *reinterpret_cast<const intptr_t *>(index + i * index_stride);
+        ix += (ix < 0) ? src0_dim_size : 0;
+        memcpy(dst + i * dst_stride, src0 + ix * src0_stride, N);
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
   /**
    * CKernel which does an indexed take operation. The child ckernel
    * should be a single unary operation.
@@ -64,9 +205,39 @@ namespace nd {
   struct DYND_API indexed_take_ck : base_strided_kernel<indexed_take_ck, 2> {
     intptr_t m_dst_dim_size, m_dst_stride, m_index_stride;
     intptr_t m_src0_dim_size, m_src0_stride;
+    // The size of the elements when they are builtin and can be copied directly, or 0
+    intptr_t m_element_size;
 
     ~indexed_take_ck() { get_child()->destroy(); }
 
+    // Copies the elements directly, returning false if they can't be
+    bool gather(char *dst, const char *src0, const char *index) {
+      switch (m_element_size) {
+      case 1:
+        detail::gather<1>(dst, m_dst_stride, src0, m_src0_dim_size, m_src0_stride, index, m_index_stride,
+                          m_dst_dim_size);
+        return true;
+      case 2:
+        detail::gather<2>(dst, m_dst_stride, src0, m_src0_dim_size, m_src0_stride, index, m_index_stride,
+                          m_dst_dim_size);
+        return true;
+      case 4:
+        detail::gather<4>(dst, m_dst_stride, src0, m_src0_dim_size, m_src0_stride, index, m_index_stride,
+                          m_dst_dim_size);
+        return true;
+      case 8:
+        detail::gather<8>(dst, m_dst_stride, src0, m_src0_dim_size, m_src0_stride, index, m_index_stride,
+                          m_dst_dim_size);
+        return true;
+      case 16:
+        detail::gather<16>(dst, m_dst_stride, src0, m_src0_dim_size, m_src0_stride, index, m_index_stride,
+                           m_dst_dim_size);
+        return true;
+      default:
+        return false;
+      }
+    }
+
     void single(char *dst, char *const *src) {
       kernel_prefix *child = get_child();
       kernel_single_t child_fn = child->get_function<kernel_single_t>();
@@ -74,10 +245,17 @@ namespace nd {
       const char *index = src[1];
       intptr_t dst_dim_size = m_dst_dim_size, src0_dim_size = m_src0_dim_size, dst_stride = m_dst_stride,
                src0_stride = m_src0_stride, index_stride = m_index_stride;
+
+      // Validate every index before copying anything, so the loops below needn't
+      detail::check_indices(index, index_stride, dst_dim_size, src0_dim_size);
+      if (gather(dst, src0, index)) {
+        return;
+      }
+
       for (intptr_t i = 0; i < dst_dim_size; ++i) {
         intptr_t ix = *reinterpret_cast<const intptr_t *>(index);
-        // Handle Python-style negative index, bounds checking
-        ix = apply_single_index(ix, src0_dim_size, NULL);
+        // Handle Python-style negative index
+        ix += (ix < 0) ? src0_dim_size : 0;
         // Copy one element at a time
         char *child_src0 = src0 + ix * src0_stride;
         child_fn(child, dst, &child_src0);
@@ -5,39 +5,210 @@
 
 #pragma once
 
-#include <dynd/bytes.hpp>
-#include <dynd/kernels/base_kernel.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <dynd/hash_util.hpp>
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/string.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    // Scrambles the bits of a key, so that the low bits of the hash depend on all of them
+    inline uint64_t hash_mix(uint64_t x) {
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ULL;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebULL;
+      x ^= x >> 31;
+      return x;
+    }
+
+    /**
+     * How the elements of a unique operation are hashed and compared, which for floating
+     * point values makes 0.0 equal to -0.0 and every NaN equal to every other.
+     */
+    template <typename T, typename Enable = void>
+    struct unique_traits {
+      static uint64_t hash(const char *data) {
+        uint64_t bits = 0;
+        memcpy(&bits, data, sizeof(T));
+        return hash_mix(bits);
+      }
+
+      static bool equal(const char *lhs, const char *rhs) {
+        return *reinterpret_cast<const T *>(lhs) == *reinterpret_cast<const T *>(rhs);
+      }
+    };
+
+    template <typename T>
+    struct unique_traits<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+      static uint64_t hash(const char *data) {
+        T value = *reinterpret_cast<const T *>(data);
+        if (value == 0) {
+          value = 0;
+        } else if (std::isnan(value)) {
+          value = std::numeric_limits<T>::quiet_NaN();
+        }
+        uint64_t bits = 0;
+        memcpy(&bits, &value, sizeof(T));
+        return hash_mix(bits);
+      }
+
+      static bool equal(const char *lhs, const char *rhs) {
+        T lhs_value = *reinterpret_cast<const T *>(lhs), rhs_value = *reinterpret_cast<const T *>(rhs);
+        return lhs_value == rhs_value || (std::isnan(lhs_value) && std::isnan(rhs_value));
+      }
+    };
+
+    template <>
+    struct unique_traits<string> {
+      static uint64_t hash(const char *data) {
+        const string &value = *reinterpret_cast<const string *>(data);
+        return hash_bytes(value.data(), value.size());
+      }
+
+      static bool equal(const char *lhs, const char *rhs) {
+        const string &lhs_value = *reinterpret_cast<const string *>(lhs);
+        const string &rhs_value = *reinterpret_cast<const string *>(rhs);
+        return lhs_value.size() == rhs_value.size() &&
+               memcmp(lhs_value.data(), rhs_value.data(), lhs_value.size()) == 0;
+      }
+    };
+
+    /**
+     * An open addressing hash table with linear probing, which numbers the distinct
+     * elements it is given in the order they first appear. The elements aren't copied,
+     * so they must stay alive as long as the table.
+     */
+    template <typename T>
+    class unique_table {
+      // The id of the element in each slot, or -1 for an empty slot
+      std::vector<intptr_t> m_slots;
+      // The first occurrence and hash of each distinct element
+      std::vector<const char *> m_firsts;
+      std::vector<uint64_t> m_hashes;
+
+      void grow() {
+        std::vector<intptr_t> slots(2 * m_slots.size(), -1);
+        size_t mask = slots.size() - 1;
+        for (size_t id = 0; id < m_firsts.size(); ++id) {
+          size_t i = m_hashes[id] & mask;
+          while (slots[i] != -1) {
+            i = (i + 1) & mask;
+          }
+          slots[i] = id;
+        }
+        m_slots.swap(slots);
+      }
+
+    public:
+      unique_table() : m_slots(1024, -1) {}
 
-  struct unique_kernel : base_kernel<unique_kernel> {
+      /**
+       * Returns the id of an element, numbering it first if it hasn't been seen.
+       */
+      intptr_t insert(const char *data) {
+        uint64_t h = unique_traits<T>::hash(data);
+        size_t mask = m_slots.size() - 1;
+        size_t i = h & mask;
+        for (intptr_t id = m_slots[i]; id != -1; id = m_slots[i]) {
+          if (m_hashes[id] == h && unique_traits<T>::equal(m_firsts[id], data)) {
+            return id;
+          }
+          i = (i + 1) & mask;
+        }
+
+        intptr_t id = m_firsts.size();
+        m_slots[i] = id;
+        m_firsts.push_back(data);
+        m_hashes.push_back(h);
+        // Keep the table at most half full
+        if (2 * m_firsts.size() > m_slots.size()) {
+          grow();
+        }
+        return id;
+      }
+
+      size_t size() const { return m_firsts.size(); }
+
+      const char *get_first(size_t id) const { return m_firsts[id]; }
+    };
+
+    template <typename T>
+    void assign_unique(char *dst, const char *src) {
+      *reinterpret_cast<T *>(dst) = *reinterpret_cast<const T *>(src);
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Finds the distinct elements of a one-dimensional array with a hash table, in
+   * order of first occurrence, without sorting or modifying the array. The values
+   * are written to a ``var`` dimension, and optionally how often each occurs to
+   * another ``var`` dimension and the id of each element to a fixed dimension.
+   */
+  template <typename Arg0Type>
+  struct unique_kernel : base_strided_kernel<unique_kernel<Arg0Type>, 1> {
+    // The data offsets of the outputs in the destination, with -1 for those not requested
+    const intptr_t values_offset;
+    const intptr_t counts_offset;
+    const intptr_t inverse_offset;
+    const ndt::var_dim_type::metadata_type *values_meta;
+    const ndt::var_dim_type::metadata_type *counts_meta;
+    const intptr_t inverse_stride;
     const intptr_t src0_size;
     const intptr_t src0_stride;
-    const intptr_t src0_element_data_size;
-
-    unique_kernel(intptr_t src0_size, intptr_t src0_stride, size_t src0_element_data_size)
-        : src0_size(src0_size), src0_stride(src0_stride), src0_element_data_size(src0_element_data_size) {}
-
-    ~unique_kernel() { get_child()->destroy(); }
-
-    void call(array *DYND_UNUSED(dst), const array *src) {
-      kernel_prefix *child = get_child();
-      size_t new_size =
-          (std::unique(strided_iterator(src[0].data(), src0_element_data_size, src0_stride),
-                       strided_iterator(src[0].data() + src0_size * src0_stride, src0_element_data_size, src0_stride),
-                       [child](char *lhs, char *rhs) {
-                         bool1 dst;
-                         char *src[2] = {lhs, rhs};
-                         child->single(reinterpret_cast<char *>(&dst), src);
-                         return dst;
-                       }) -
-           src[0].data()) /
-          src0_stride;
-
-//      src[0]->set_type(
-  //        ndt::make_fixed_dim(new_size, src[0]->get_type().extended<ndt::fixed_dim_type>()->get_element_type()));
-      reinterpret_cast<size_stride_t *>(src[0]->metadata())->dim_size = new_size;
+
+    unique_kernel(intptr_t values_offset, intptr_t counts_offset, intptr_t inverse_offset,
+                  const ndt::var_dim_type::metadata_type *values_meta,
+                  const ndt::var_dim_type::metadata_type *counts_meta, intptr_t inverse_stride, intptr_t src0_size,
+                  intptr_t src0_stride)
+        : values_offset(values_offset), counts_offset(counts_offset), inverse_offset(inverse_offset),
+          values_meta(values_meta), counts_meta(counts_meta), inverse_stride(inverse_stride), src0_size(src0_size),
+          src0_stride(src0_stride) {}
+
+    void single(char *dst, char *const *src) {
+      detail::unique_table<Arg0Type> table;
+      std::vector<intptr_t> counts;
+      char *inverse = (inverse_offset >= 0) ? (dst + inverse_offset) : NULL;
+
+      const char *src0 = src[0];
+      for (intptr_t i = 0; i < src0_size; ++i, src0 += src0_stride) {
+        intptr_t id = table.insert(src0);
+        if (counts_offset >= 0) {
+          if (static_cast<size_t>(id) == counts.size()) {
+            counts.push_back(0);
+          }
+          ++counts[id];
+        }
+        if (inverse != NULL) {
+          *reinterpret_cast<intptr_t *>(inverse) = id;
+          inverse += inverse_stride;
+        }
+      }
+
+      size_t n = table.size();
+      ndt::var_dim_type::data_type *values = reinterpret_cast<ndt::var_dim_type::data_type *>(dst + values_offset);
+      values->begin = values_meta->blockref->alloc(n);
+      values->size = n;
+      for (size_t id = 0; id < n; ++id) {
+        detail::assign_unique<Arg0Type>(values->begin + id * values_meta->stride, table.get_first(id));
+      }
+
+      if (counts_offset >= 0) {
+        ndt::var_dim_type::data_type *dst_counts =
+            reinterpret_cast<ndt::var_dim_type::data_type *>(dst + counts_offset);
+        dst_counts->begin = counts_meta->blockref->alloc(n);
+        dst_counts->size = n;
+        for (size_t id = 0; id < n; ++id) {
+          *reinterpret_cast<intptr_t *>(dst_counts->begin + id * counts_meta->stride) = counts[id];
+        }
+      }
     }
   };
 
@@ -5,11 +5,30 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/mask_util.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    // The number of elements whose predicate is evaluated at a time
+    static const size_t where_block_size = 4096;
+
+    // The smallest capacity a nonempty result is given
+    static const size_t where_min_capacity = 16;
 
+  } // namespace dynd::nd::detail
+
+  /**
+   * Appends the index of every element for which the child predicate is true to a ``var``
+   * dimension. A run of elements is handled in blocks, first evaluating the predicate over
+   * the block into a mask and counting its matches, then growing the result once and filling
+   * it. The result grows geometrically, and is trimmed to its size at the end of the run.
+   */
   struct where_kernel : base_strided_kernel<where_kernel, 2> {
     size_t &it;
     intptr_t ret_stride;
@@ -21,27 +40,73 @@ namespace nd {
         : it(*reinterpret_cast<size_t *>(data)), ret_stride(ret_stride), dst_memory_block(dst_memory_block),
           ret_element_size(sizeof(intptr_t)), capacity(0) {}
 
-    void single(char *ret, char *const *src) {
-      bool child_ret;
-      get_child()->single(reinterpret_cast<char *>(&child_ret), src);
-
-      if (child_ret) {
-        const state &src1 = *reinterpret_cast<state *>(src[1]);
-
-        size_t &size = reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->size;
-        if (size == 0) {
-          capacity = 1;
-          reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin = dst_memory_block->alloc(capacity);
-        } else if (size == capacity) {
-          capacity = size + 1;
-          reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin =
-              dst_memory_block->resize(reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin, capacity);
+    ~where_kernel() { get_child()->destroy(); }
+
+    /**
+     * Makes room for at least ``n`` indices in the result.
+     */
+    void reserve(ndt::var_dim_type::data_type *ret, size_t n) {
+      if (ret->size == 0) {
+        capacity = std::max(n, detail::where_min_capacity);
+        ret->begin = dst_memory_block->alloc(capacity);
+      } else if (n > capacity) {
+        capacity = std::max(n, 2 * capacity);
+        ret->begin = dst_memory_block->resize(ret->begin, capacity);
+      }
+    }
+
+    /**
+     * Appends the indices of the matches among ``count`` elements, numbered from ``first``.
+     */
+    void append(ndt::var_dim_type::data_type *ret, char *const *src, const intptr_t *src_stride, size_t first,
+                size_t count) {
+      kernel_prefix *child = get_child();
+      char mask[detail::where_block_size];
+      static const intptr_t mask_stride = 1;
+
+      char *src_copy[2] = {src[0], src[1]};
+      for (size_t i = 0; i < count; i += detail::where_block_size) {
+        size_t n = std::min(count - i, detail::where_block_size);
+        child->strided(mask, mask_stride, src_copy, src_stride, n);
+        src_copy[0] += n * src_stride[0];
+
+        size_t nmatch = detail::count_mask(mask, n);
+        if (nmatch == 0) {
+          continue;
         }
-        ++size;
 
-        intptr_t *index = reinterpret_cast<intptr_t *>(reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin +
-                                                       (size - 1) * ret_stride);
-        *index = src1.index[0];
+        // One more than needed, so the fill below can always write past the last match
+        reserve(ret, ret->size + nmatch + 1);
+        char *dst = ret->begin + ret->size * ret_stride;
+        for (size_t j = 0; j < n; ++j) {
+          *reinterpret_cast<intptr_t *>(dst) = first + i + j;
+          dst += mask[j] * ret_stride;
+        }
+        ret->size += nmatch;
+      }
+    }
+
+    void single(char *ret, char *const *src) {
+      static const intptr_t src_stride[2] = {0, 0};
+      append(reinterpret_cast<ndt::var_dim_type::data_type *>(ret), src, src_stride,
+             reinterpret_cast<state *>(src[1])->index[0], 1);
+    }
+
+    void strided(char *ret, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t end) {
+      if (dst_stride != 0) {
+        base_strided_kernel<where_kernel, 2>::strided(ret, dst_stride, src, src_stride, end);
+        return;
+      }
+
+      ndt::var_dim_type::data_type *dst = reinterpret_cast<ndt::var_dim_type::data_type *>(ret);
+      size_t first = begin();
+      append(dst, src, src_stride, first, end - first);
+      it = end;
+
+      // Give back the unused capacity
+      if (dst->size != 0 && dst->size < capacity) {
+        capacity = dst->size;
+        dst->begin = dst_memory_block->resize(dst->begin, capacity);
       }
     }
 
@@ -58,6 +58,17 @@ namespace nd {
      */
     virtual void reset() { throw std::runtime_error("reset is not implemented"); }
 
+    /**
+     * Takes over all the memory allocated from another memory block of the same
+     * kind, so that it lives as long as this one, without moving it. The other
+     * memory block can't be used to allocate memory afterwards. This lets
+     * separate threads allocate from their own memory blocks, and then combine
+     * what they allocated.
+     */
+    virtual void absorb(base_memory_block &DYND_UNUSED(other)) {
+      throw std::runtime_error("absorb is not implemented");
+    }
+
     /**
      * Does a debug dump of the memory block.
      */
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
 
 #ifdef _WIN32
@@ -21,6 +23,7 @@
 #endif
 
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/buffer_memory_block.hpp>
 
 namespace dynd {
 
@@ -67,6 +70,8 @@ namespace nd {
    *
    * \param filename  The filename of the file to memory map.
    * \param access  A combination of write_access_flag, read_access_flag, immutable_access_flag.
+   *                The file is mapped writable, with changes written back to it, if
+   *                write_access_flag is included, and read-only otherwise.
    * \param out_pointer  This is the pointer to the mapped memory.
    * \param out_size  This is the size of the mapped memory. Note that the size may be different
    *                  than requested by begin/end, because this function uses Python semantics to
@@ -97,10 +102,10 @@ namespace nd {
     intptr_t m_mapOffset;
 
   public:
-    memmap_memory_block(const std::string &filename, uint32_t DYND_UNUSED(access), char **out_pointer,
-                        intptr_t *out_size, intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max())
+    memmap_memory_block(const std::string &filename, uint32_t access, char **out_pointer, intptr_t *out_size,
+                        intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max())
         : m_filename(filename), m_begin(begin), m_end(end) {
-      bool readwrite = false; // ((access & nd::write_access_flag) == nd::write_access_flag);
+      bool readwrite = ((access & nd::write_access_flag) == nd::write_access_flag);
 #ifdef WIN32
       // TODO: This function isn't quite exception-safe, use a smart pointer for the handles to fix.
 
@@ -179,6 +184,7 @@ namespace nd {
 #endif
       struct stat st;
       if (fstat(m_fd, &st) == -1) {
+        close(m_fd);
         std::stringstream ss;
         ss << "failed to stat file \"" << m_filename << "\" for memory mapping";
         throw std::runtime_error(ss.str());
@@ -196,6 +202,14 @@ namespace nd {
       m_mapOffset = begin - mapbegin;
       intptr_t mapsize = end - mapbegin;
 
+      if (mapsize == 0) {
+        // An empty region has nothing to map, which mmap rejects
+        m_mapPointer = NULL;
+        *out_pointer = NULL;
+        *out_size = 0;
+        return;
+      }
+
       m_mapPointer = (char *)mmap(NULL, mapsize, PROT_READ | (readwrite ? PROT_WRITE : 0), MAP_SHARED, m_fd, mapbegin);
       if (m_mapPointer == (char *)MAP_FAILED) {
         close(m_fd);
@@ -215,8 +229,10 @@ namespace nd {
       CloseHandle(m_hMapFile);
       CloseHandle(m_hFile);
 #else
-      intptr_t mapsize = m_end - m_begin + m_mapOffset;
-      munmap((void *)m_mapPointer, mapsize);
+      if (m_mapPointer != NULL) {
+        intptr_t mapsize = m_end - m_begin + m_mapOffset;
+        munmap((void *)m_mapPointer, mapsize);
+      }
       close(m_fd);
 #endif
     }
@@ -113,12 +113,14 @@ namespace nd {
 
       if (mc->capacity_count - previous_index < count) {
         append_memory(std::max(m_total_allocated_count, count));
+        // Appending may have moved the chunks
+        mc = &m_memory_handles[m_memory_handles.size() - 2];
         memory_chunk *new_mc = &m_memory_handles.back();
         // Move the old memory to the newly allocated block
         if (previous_count > 0) {
           // Subtract the previously used memory from the old chunk's count
           mc->used_count -= previous_count;
-          memcpy(new_mc->memory, previous_allocated, previous_count);
+          memcpy(new_mc->memory, previous_allocated, m_stride * previous_count);
           // If the old memory only had the memory being resized,
           // free it completely.
           if (previous_allocated == mc->memory) {
@@ -146,7 +148,7 @@ namespace nd {
         // Zero-init the new memory
         intptr_t new_count = count - (intptr_t)previous_count;
         if (new_count > 0) {
-          memset(mc->memory + m_stride * previous_count, 0, m_stride * new_count);
+          memset(result + m_stride * previous_count, 0, m_stride * new_count);
         }
       } else {
         // TODO: Add a default data constructor to base_type
@@ -166,16 +168,27 @@ namespace nd {
         // throw them all away except the last
         for (size_t i = 0, i_end = m_memory_handles.size() - 1; i != i_end; ++i) {
           memory_chunk &mc = m_memory_handles[i];
-          m_dt.extended()->data_destruct_strided(m_arrmeta, mc.memory, m_stride, mc.used_count);
+          m_dt.extended()->data_destruct_strided(m_arrmeta + arrmeta_size, mc.memory, m_stride, mc.used_count);
           free(mc.memory);
         }
         m_memory_handles.front() = m_memory_handles.back();
         m_memory_handles.resize(1);
-        // Reset to zero used elements in the chunk
-        memory_chunk &mc = m_memory_handles.front();
-        m_dt.extended()->data_destruct_strided(m_arrmeta, mc.memory, m_stride, mc.used_count);
-        mc.used_count = 0;
       }
+
+      // Reset to zero used elements in the chunk
+      memory_chunk &mc = m_memory_handles.front();
+      m_dt.extended()->data_destruct_strided(m_arrmeta + arrmeta_size, mc.memory, m_stride, mc.used_count);
+      mc.used_count = 0;
+      m_total_allocated_count = mc.capacity_count;
+    }
+
+    void absorb(base_memory_block &other) {
+      objectarray_memory_block &src = dynamic_cast<objectarray_memory_block &>(other);
+      // The chunk being doled out stays last, where alloc(), resize() and reset() expect it
+      m_memory_handles.insert(m_memory_handles.end() - 1, src.m_memory_handles.begin(), src.m_memory_handles.end());
+      m_total_allocated_count += src.m_total_allocated_count;
+      src.m_memory_handles.clear();
+      src.m_total_allocated_count = 0;
     }
 
     void debug_print(std::ostream &o, const std::string &indent) {
@@ -812,6 +812,18 @@ std::enable_if_t<is_signed<T>::value && is_integral<T>::value, T> parse(const ch
   return 0;
 }
 
+/**
+ * Converts a string containing only a decimal floating point number, an optional
+ * sign followed by digits with an optional decimal point and exponent, to the
+ * nearest float64 or float32 value, with ties rounded to even. It doesn't allocate
+ * memory, and needs more than one 64-bit multiplication only for the rare numbers
+ * close to halfway between two values.
+ *
+ * Returns false, leaving ``out`` untouched, if the string isn't such a number.
+ */
+DYNDT_API bool parse_decimal_float(const char *begin, const char *end, double &out);
+DYNDT_API bool parse_decimal_float(const char *begin, const char *end, float &out);
+
 /**
  * Converts a string containing only a floating point number into
  * a float64/C double.
@@ -856,10 +868,15 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
+  T value;
+  if (parse_decimal_float(begin, end, value)) {
+    return value;
+  }
+
+  // Leave any other spelling, like a hexadecimal float, to the C library
   char *end_ptr;
   std::string s(begin, end);
-  return strtod(s.c_str(), &end_ptr);
+  return strto<T>(s.c_str(), &end_ptr);
 }
 
 template <typename T>
@@ -1069,10 +1086,16 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
+  T value;
+  if (parse_decimal_float(begin, end, value)) {
+    return value;
+  }
+
+  // Leave any other spelling, like a hexadecimal float, to the C library
   char *end_ptr;
-  T value = strto<T>(begin, &end_ptr);
-  if (end_ptr - begin != end - begin) {
+  std::string s(begin, end);
+  value = strto<T>(s.c_str(), &end_ptr);
+  if (end_ptr - s.c_str() != end - begin) {
     std::stringstream ss;
     ss << "parse error converting string ";
     ss.write(begin, end - begin);
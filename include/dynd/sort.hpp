@@ -11,6 +11,23 @@ namespace dynd {
 namespace nd {
 
   extern DYND_API callable sort;
+
+  /**
+   * Returns the ``N * intptr`` indices that sort a one-dimensional array, which
+   * ``nd::take`` gathers the sorted array with. Equal elements keep their order if
+   * the ``stable`` keyword is true.
+   */
+  extern DYND_API callable argsort;
+
+  /**
+   * Returns the distinct elements of a one-dimensional array of builtin numbers or
+   * strings as a ``var`` dimension, in order of first occurrence. Floating point
+   * values treat 0.0 and -0.0 as one value, and all NaNs as one value.
+   *
+   * If the ``counts`` or ``inverse`` keywords are true, the result is instead a struct
+   * with a ``values`` field, a ``counts`` field holding how often each value occurs,
+   * and an ``inverse`` field holding the position in ``values`` of each element.
+   */
   extern DYND_API callable unique;
 
 } // namespace dynd::nd
@@ -10,6 +10,13 @@
 namespace dynd {
 namespace nd {
 
+  /**
+   * Reduces numeric values to a ``{count, sum, min, max, mean, var}`` struct in a single pass,
+   * where ``var`` is the population variance. It takes the same ``axes`` and ``keepdims``
+   * keywords as the other reductions, and splits a full reduction across threads.
+   */
+  extern DYND_API callable describe;
+
   extern DYND_API callable max;
   extern DYND_API callable mean;
   extern DYND_API callable min;
@@ -10,6 +10,7 @@
 #include <map>
 #include <new>
 
+#include <dynd/arena.hpp>
 #include <dynd/visibility.hpp>
 
 namespace dynd {
@@ -21,6 +22,8 @@ protected:
   char *m_data;
   intptr_t m_capacity;
   intptr_t m_size;
+  // The arena that storage outgrowing the static data comes from, or NULL for the heap
+  arena *m_arena;
 
   // When the amount of data is small, this static data is used,
   // otherwise dynamic memory is allocated when it gets too big
@@ -29,12 +32,12 @@ protected:
   bool using_static_data() const { return m_data == &m_static_data[0]; }
 
 public:
-  storagebuf() : m_data(m_static_data), m_capacity(sizeof(m_static_data)), m_size(0) {
+  storagebuf(arena *a = NULL) : m_data(m_static_data), m_capacity(sizeof(m_static_data)), m_size(0), m_arena(a) {
     set(m_static_data, 0, sizeof(m_static_data));
   }
 
   ~storagebuf() {
-    if (!using_static_data() && m_data != NULL) {
+    if (m_data != NULL) {
       free(m_data);
     }
   }
@@ -71,11 +74,11 @@ public:
     }
   }
 
-  void *alloc(size_t size) { return std::malloc(size); }
+  void *alloc(size_t size) { return (m_arena == NULL) ? std::malloc(size) : m_arena->allocate(size); }
 
   void *realloc(void *ptr, size_t old_size, size_t new_size) {
-    if (using_static_data()) {
-      // If we were previously using the static data, do a malloc
+    if (using_static_data() || m_arena != NULL) {
+      // If we were previously using the static data or are in an arena, allocate and copy
       void *new_data = alloc(new_size);
       // If the allocation succeeded, copy the old data as the realloc would
       if (new_data != NULL) {
@@ -88,7 +91,8 @@ public:
   }
 
   void free(void *ptr) {
-    if (!using_static_data()) {
+    // Storage in an arena is reclaimed with the arena
+    if (!using_static_data() && m_arena == NULL) {
       std::free(ptr);
     }
   }
@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * A fixed set of worker threads that kernels can split a loop across.
+ *
+ * The tasks of a run are dealt out to the participating threads in contiguous
+ * ranges. Each thread works through its own range from the front, and once it
+ * runs dry it steals tasks from the back of the other ranges, so that uneven
+ * tasks still balance out. The calling thread always participates as thread 0,
+ * and a run started from inside a task executes serially on that thread.
+ */
+class DYND_API thread_pool {
+  struct job;
+
+  std::vector<std::thread> m_threads;
+  std::atomic<size_t> m_nworkers;
+  std::mutex m_run_mutex;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  job *m_job;
+  size_t m_generation;
+  bool m_stop;
+
+  void work(size_t thread);
+
+public:
+  /**
+   * Starts a pool with ``nworkers`` threads in addition to the calling one.
+   */
+  thread_pool(size_t nworkers);
+
+  thread_pool(const thread_pool &) = delete;
+
+  ~thread_pool();
+
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  /**
+   * The maximum number of threads that can participate in a run, including the calling one.
+   */
+  size_t get_nthreads() const { return m_nworkers + 1; }
+
+  /**
+   * Starts more workers if needed so that at least ``nthreads`` threads can participate
+   * in a run, for when more threads than the hardware has are wanted.
+   */
+  void reserve(size_t nthreads);
+
+  /**
+   * Calls ``f(task, thread)`` for every task in [0, ntasks), using up to ``nthreads``
+   * threads. The thread index is in [0, nthreads), and no two tasks run concurrently
+   * with the same thread index, so it can be used to select per-thread state. The first
+   * exception thrown by a task is rethrown once all the threads have stopped.
+   */
+  void run(size_t nthreads, size_t ntasks, const std::function<void(size_t, size_t)> &f);
+
+  /**
+   * Returns true when called from inside a task of some run.
+   */
+  static bool in_task();
+
+  /**
+   * The process-wide pool, sized to the hardware concurrency.
+   */
+  static thread_pool &get();
+};
+
+} // namespace dynd
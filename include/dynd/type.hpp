@@ -74,6 +74,13 @@ namespace ndt {
   DYNDT_API type make_fixed_dim(size_t dim_size, const type &element_tp);
   inline type make_var_dim(const type &element_tp);
 
+  /**
+   * Mixes a value into a hash, for combining the hashes of the parameters of a type.
+   */
+  inline size_t hash_combine(size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+  }
+
   template <typename T>
   struct traits {
     ~traits() = delete;
@@ -145,13 +152,22 @@ namespace ndt {
     type(const char *rep_begin, const char *rep_end);
 
     bool operator==(const type &rhs) const {
-      return m_ptr == rhs.m_ptr || (!is_builtin() && !rhs.is_builtin() && *m_ptr == *rhs.m_ptr);
+      return m_ptr == rhs.m_ptr || (!is_builtin() && !rhs.is_builtin() &&
+                                    !(m_ptr->is_interned() && rhs.m_ptr->is_interned()) && *m_ptr == *rhs.m_ptr);
     }
 
     bool operator!=(const type &rhs) const { return !(operator==(rhs)); }
 
     bool is_null() const { return m_ptr == NULL; }
 
+    /**
+     * A hash of the type, equal for types that compare equal. For an interned type
+     * this is a stored value.
+     */
+    size_t hash() const {
+      return is_builtin() ? static_cast<size_t>(reinterpret_cast<uintptr_t>(m_ptr)) : m_ptr->hash();
+    }
+
     /**
      * Returns true if this type is built in, which
      * means the type id is encoded directly in the m_ptr
@@ -724,66 +740,66 @@ namespace ndt {
   }
 
   /**
-   * Allocates and constructs a type with a use count of 1.
+   * Constructs a type, returning the interned instance equal to it.
    */
   template <typename T, typename... ArgTypes>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(ArgTypes &&... args) {
-    return type(new T(id_of<T>::value, std::forward<ArgTypes>(args)...), false);
+    return intern(type(new T(id_of<T>::value, std::forward<ArgTypes>(args)...), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(std::initializer_list<type> field_tp) {
-    return type(new T(id_of<T>::value, field_tp), false);
+    return intern(type(new T(id_of<T>::value, field_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(std::initializer_list<type> field_tp,
                                                                          bool variadic) {
-    return type(new T(id_of<T>::value, field_tp, variadic), false);
+    return intern(type(new T(id_of<T>::value, field_tp, variadic), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(std::initializer_list<std::string> field_names,
                                                                          std::initializer_list<type> field_tp) {
-    return type(new T(id_of<T>::value, field_names, field_tp), false);
+    return intern(type(new T(id_of<T>::value, field_names, field_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(std::initializer_list<std::pair<type, std::string>> fields) {
-    return type(new T(id_of<T>::value, fields), false);
+    return intern(type(new T(id_of<T>::value, fields), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(std::initializer_list<std::pair<type, std::string>> fields, bool variadic) {
-    return type(new T(id_of<T>::value, fields, variadic), false);
+    return intern(type(new T(id_of<T>::value, fields, variadic), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(std::initializer_list<std::string> field_names, std::initializer_list<type> field_tp, bool variadic) {
-    return type(new T(id_of<T>::value, field_names, field_tp, variadic), false);
+    return intern(type(new T(id_of<T>::value, field_names, field_tp, variadic), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(const type &ret_tp,
                                                                          std::initializer_list<type> arg_tp) {
-    return type(new T(id_of<T>::value, ret_tp, arg_tp), false);
+    return intern(type(new T(id_of<T>::value, ret_tp, arg_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(const type &ret_tp, std::initializer_list<type> arg_tp,
             std::initializer_list<std::pair<type, std::string>> kwd_tp) {
-    return type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false);
+    return intern(type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(const type &ret_tp, std::initializer_list<type> arg_tp,
             const std::vector<std::pair<type, std::string>> &kwd_tp) {
-    return type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false);
+    return intern(type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false));
   }
 
   /*
@@ -988,6 +1004,19 @@ namespace ndt {
     }
   };
 
+  template <>
+  struct traits<summation_mode> {
+    static const size_t ndim = 0;
+
+    static const bool is_same_layout = true;
+
+    static type equivalent() { return make_type<typename std::underlying_type<summation_mode>::type>(); }
+
+    static summation_mode na() {
+      return static_cast<summation_mode>(traits<typename std::underlying_type<summation_mode>::type>::na());
+    }
+  };
+
   template <typename ContainerType, size_t NDim>
   struct container_traits {
     static const size_t ndim = NDim;
@@ -1151,3 +1180,12 @@ DYNDT_API void print_indented(std::ostream &o, const std::string &indent, const
 DYNDT_API bool is_lossless_assignment(const ndt::type &dst_tp, const ndt::type &src_tp);
 
 } // namespace dynd
+
+namespace std {
+
+template <>
+struct hash<dynd::ndt::type> {
+  size_t operator()(const dynd::ndt::type &tp) const { return tp.hash(); }
+};
+
+} // namespace std
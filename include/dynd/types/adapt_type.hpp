@@ -47,6 +47,8 @@ namespace ndt {
     void print_data(std::ostream &o, const char *arrmeta, const char *data) const;
 
     bool operator==(const base_type &rhs) const;
+
+    size_t get_hash() const;
   };
 
   template <>
@@ -20,6 +20,20 @@ namespace ndt {
 
   class type;
 
+  /**
+   * Returns the interned instance of a type, which is shared by every interned type
+   * equal to it. Interned types are compared by pointer and hashed without visiting
+   * their parameters. The table of interned types holds no references, so a type
+   * leaves it when its last reference goes away.
+   */
+  DYNDT_API type intern(const type &tp);
+
+  /**
+   * Returns the interned type for a datashape string. The string to type mapping is
+   * remembered while the type is alive, so repeated strings aren't parsed again.
+   */
+  DYNDT_API type intern_datashape(const char *begin, const char *end);
+
 } // namespace dynd::ndt
 
 struct iterdata_common;
@@ -86,6 +100,10 @@ namespace ndt {
   class DYNDT_API base_type {
     /** Embedded reference counting */
     mutable std::atomic_long m_use_count;
+    /** Whether the type is in the table of interned types, see ndt::intern */
+    std::atomic<bool> m_interned;
+    /** The hash of the type, once it is interned */
+    size_t m_hash;
 
   protected:
     type_id_t m_id;          // The type id
@@ -100,14 +118,24 @@ namespace ndt {
     /** Starts off the extended type instance with a use count of 1. */
     base_type(type_id_t id, size_t data_size, size_t data_alignment, uint32_t flags, size_t arrmeta_size, size_t ndim,
               size_t strided_ndim)
-        : m_use_count(1), m_id(id), m_metadata_size(arrmeta_size), m_data_size(data_size),
-          m_data_alignment(data_alignment), flags(flags), m_ndim(ndim), m_fixed_ndim(strided_ndim) {}
+        : m_use_count(1), m_interned(false), m_hash(0), m_id(id), m_metadata_size(arrmeta_size),
+          m_data_size(data_size), m_data_alignment(data_alignment), flags(flags), m_ndim(ndim),
+          m_fixed_ndim(strided_ndim) {}
 
     virtual ~base_type();
 
     /** For debugging purposes, the type's use count */
     int32_t get_use_count() const { return m_use_count; }
 
+    /**
+     * Whether this is the interned instance of the type. No two interned types are equal,
+     * so interned types are equal exactly when they are the same instance.
+     */
+    bool is_interned() const { return m_interned.load(std::memory_order_acquire); }
+
+    /** The hash of the type, which is stored for an interned type */
+    size_t hash() const { return is_interned() ? m_hash : get_hash(); }
+
     /**
       * The type's id.
       */
@@ -372,6 +400,12 @@ namespace ndt {
 
     virtual bool operator==(const base_type &rhs) const = 0;
 
+    /**
+     * A hash of the type, which must be equal for types that compare equal. The default
+     * hashes the type id, and types with parameters should combine the hashes of those.
+     */
+    virtual size_t get_hash() const;
+
     /**
      * Constructs the nd::array arrmeta for this type using default settings.
      * The element size of the result must match that from
@@ -484,6 +518,8 @@ namespace ndt {
     friend long intrusive_ptr_use_count(const base_type *ptr);
 
     friend type make_dynamic_type(type_id_t tp_id);
+    friend type intern(const type &tp);
+    friend type intern_datashape(const char *begin, const char *end);
   };
 
   /**
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <dynd/array.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -31,6 +33,13 @@ namespace ndt {
     nd::array m_category_index_to_value;
     // mapping from values to category indices
     nd::array m_value_to_category_index;
+    // hash table from categories to values, with linear probing, or empty if the
+    // category type isn't hashable. Each slot holds a value, or -1 if it is empty.
+    std::vector<intptr_t> m_value_table;
+    uint64_t (*m_category_hash)(const char *);
+    bool (*m_category_equal)(const char *, const char *);
+
+    void build_value_table();
 
   public:
     categorical_type(type_id_t new_id, const nd::array &categories, bool presorted = false);
@@ -59,6 +68,21 @@ namespace ndt {
     uint32_t get_value_from_category(const char *category_arrmeta, const char *category_data) const;
     uint32_t get_value_from_category(const nd::array &category) const;
 
+    /**
+     * Encodes ``count`` values of the category type as their values in this type,
+     * written with its storage type. Raises an exception for any value that isn't
+     * one of the categories.
+     *
+     * \param dst  The destination of the first value.
+     * \param dst_stride  The stride between destination values.
+     * \param src_arrmeta  The arrmeta of the source values.
+     * \param src  The first source value.
+     * \param src_stride  The stride between source values.
+     * \param count  The number of values.
+     */
+    void encode(char *dst, intptr_t dst_stride, const char *src_arrmeta, const char *src, intptr_t src_stride,
+                size_t count) const;
+
     const char *get_category_data_from_value(uint32_t value) const {
       if (value >= get_category_count()) {
         throw std::runtime_error("category value is out of bounds");
@@ -78,6 +102,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t get_hash() const;
+
     void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
     void arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrmeta,
                                 const nd::memory_block &embedded_reference) const;
@@ -95,7 +121,7 @@ namespace ndt {
   };
 
   template <>
-  struct id_of<categorical_type> : std::integral_constant<type_id_t, categorical_kind_id> {};
+  struct id_of<categorical_type> : std::integral_constant<type_id_t, categorical_id> {};
 
   DYND_API type factor_categorical(const nd::array &values);
 
@@ -53,6 +53,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t get_hash() const;
+
     type get_type_at_dimension(char **inout_arrmeta, intptr_t i, intptr_t total_ndim = 0) const;
 
     void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
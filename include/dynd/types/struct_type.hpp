@@ -48,6 +48,15 @@ namespace ndt {
 
     bool m_variadic;
 
+    /**
+     * An open addressing hash table of the field names, with linear probing. Each
+     * slot holds the index of a field, or -1 if it is empty. Its size is a power of
+     * two at least twice the number of fields.
+     */
+    std::vector<intptr_t> m_field_index_table;
+
+    void build_field_index_table();
+
   public:
     struct_type(type_id_t id, const std::vector<std::string> &field_names, const std::vector<type> &field_types,
                 bool variadic = false)
@@ -90,6 +99,8 @@ namespace ndt {
       for (intptr_t i = 0; i < m_field_count; ++i) {
         m_field_tp.emplace_back(field_types[i], field_names[i]);
       }
+
+      build_field_index_table();
     }
 
     struct_type(type_id_t id, const std::vector<std::pair<type, std::string>> &fields, bool variadic = false)
@@ -123,7 +134,22 @@ namespace ndt {
      * \returns  The field index, or -1 if there is no field
      *           of the given name.
      */
-    intptr_t get_field_index(const std::string &field_name) const;
+    intptr_t get_field_index(const std::string &field_name) const {
+      return get_field_index(field_name.data(), field_name.size());
+    }
+
+    /**
+     * Gets the field index for the name given as a range of characters,
+     * e.g. a key inside a buffer being parsed. Returns -1 if the struct
+     * doesn't have a field of the given name.
+     *
+     * \param name  The start of the name.
+     * \param size  The length of the name.
+     *
+     * \returns  The field index, or -1 if there is no field
+     *           of the given name.
+     */
+    intptr_t get_field_index(const char *name, size_t size) const;
 
     /**
      * Gets the field type for the given name. Raises std::invalid_argument if
@@ -154,6 +180,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t get_hash() const;
+
     void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
     void arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrmeta,
                                 const nd::memory_block &embedded_reference) const;
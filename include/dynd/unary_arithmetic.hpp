@@ -14,9 +14,9 @@ using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-                                       const ndt::type *src_tp) {
-  return {src_tp[0]};
+static void func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                     ndt::type *res) {
+  res[0] = src_tp[0];
 }
 
 typedef type_sequence<uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, float, double,
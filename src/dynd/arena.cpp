@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+#include <new>
+
+#include <dynd/arena.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// The alignment keeps the data after the header 16-byte aligned
+struct alignas(16) arena::block {
+  block *next;
+  size_t capacity;
+
+  char *data() { return reinterpret_cast<char *>(this + 1); }
+};
+
+namespace {
+
+size_t aligned_size(size_t size) { return (size + static_cast<size_t>(15)) & ~static_cast<size_t>(15); }
+
+} // anonymous namespace
+
+arena::arena(size_t block_size) : m_first(NULL), m_current(NULL), m_used(0), m_block_size(block_size) {}
+
+arena::~arena() {
+  block *b = m_first;
+  while (b != NULL) {
+    block *next = b->next;
+    free(b);
+    b = next;
+  }
+}
+
+void *arena::allocate(size_t size) {
+  size = aligned_size(size);
+  if (m_current != NULL && m_used + size <= m_current->capacity) {
+    void *res = m_current->data() + m_used;
+    m_used += size;
+    return res;
+  }
+
+  // Move on to the next block, making a new one if there is none or it is too small
+  block *next = (m_current == NULL) ? m_first : m_current->next;
+  if (next == NULL || next->capacity < size) {
+    size_t capacity = (size > m_block_size) ? size : m_block_size;
+    block *b = reinterpret_cast<block *>(malloc(sizeof(block) + capacity));
+    if (b == NULL) {
+      throw bad_alloc();
+    }
+    b->capacity = capacity;
+    b->next = next;
+    if (m_current == NULL) {
+      m_first = b;
+    } else {
+      m_current->next = b;
+    }
+    next = b;
+  }
+
+  m_current = next;
+  m_used = size;
+  return m_current->data();
+}
+
+size_t arena::capacity() const {
+  size_t res = 0;
+  for (block *b = m_first; b != NULL; b = b->next) {
+    res += b->capacity;
+  }
+
+  return res;
+}
+
+arena &arena::get() {
+  static thread_local arena a;
+  return a;
+}
@@ -24,6 +24,7 @@
 #include <dynd/types/datashape_formatter.hpp>
 #include <dynd/types/datashape_formatter.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
+#include <dynd/types/fixed_dim_kind_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/string_type.hpp>
@@ -886,37 +887,60 @@ nd::array nd::reshape(const nd::array &a, const nd::array &shape) {
                                       NULL);
 }
 
-nd::array nd::memmap(const std::string &DYND_UNUSED(filename), intptr_t DYND_UNUSED(begin), intptr_t DYND_UNUSED(end),
-                     uint32_t DYND_UNUSED(access)) {
-  throw std::runtime_error("nd::memmap is not yet implemented");
+nd::array nd::memmap(const std::string &filename, const ndt::type &tp, intptr_t begin, intptr_t end,
+                     uint32_t access) {
+  // A leading Fixed dimension takes its size from the file
+  bool fixed_kind = tp.get_id() == fixed_dim_kind_id;
+  ndt::type el_tp = fixed_kind ? tp.extended<ndt::base_dim_type>()->get_element_type() : tp;
+  if (el_tp.is_symbolic() || (el_tp.get_flags() & (type_flag_blockref | type_flag_destructor)) != 0 ||
+      el_tp.get_default_data_size() == 0) {
+    stringstream ss;
+    ss << "cannot memory map a file as type " << tp << ", which does not have a fixed size";
+    throw type_error(ss.str());
+  }
 
-  /*
-    // ToDo: This was based on the variable-sized bytes type, which changed.
+  if ((access & read_access_flag) == 0) {
+    access |= read_access_flag;
+  }
 
-    if (access == 0) {
-      access = nd::default_access_flags;
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  memory_block mm = make_memory_block<memmap_memory_block>(filename, access, &mm_ptr, &mm_size, begin, end);
+
+  size_t el_size = el_tp.get_default_data_size();
+  ndt::type res_tp = tp;
+  if (fixed_kind) {
+    if (static_cast<size_t>(mm_size) % el_size != 0) {
+      stringstream ss;
+      ss << "cannot memory map " << mm_size << " bytes of file \"" << filename << "\" as type " << tp
+         << ", as it is not a multiple of the " << el_size << " byte element size";
+      throw invalid_argument(ss.str());
     }
+    res_tp = ndt::make_fixed_dim(mm_size / el_size, el_tp);
+  } else if (static_cast<size_t>(mm_size) < el_size) {
+    stringstream ss;
+    ss << "cannot memory map " << mm_size << " bytes of file \"" << filename << "\" as type " << tp
+       << ", which requires " << el_size << " bytes";
+    throw invalid_argument(ss.str());
+  }
 
-    char *mm_ptr = NULL;
-    intptr_t mm_size = 0;
-    // Create a memory mapped memblock of the file
-    intrusive_ptr<memory_block_data> mm = make_memmap_memory_block(filename, access, &mm_ptr, &mm_size, begin, end);
-    // Create a bytes array referring to the data.
-    ndt::type dt = ndt::make_type<ndt::bytes_type>(1);
-    char *data_ptr = 0;
-    nd::array result(make_array(dt.extended()->get_arrmeta_size(), dt.get_data_size(),
-                                             dt.get_data_alignment(), &data_ptr));
-    // Set the bytes extents
-    reinterpret_cast<bytes *>(data_ptr)->assign(mm_ptr, mm_size);
-    // Set the array arrmeta
-    array_preamble *ndo = result.get();
-    ndo->set_type(dt);
-    ndo->flags = access;
-    // Set the bytes arrmeta, telling the system
-    // about the memmapped memblock
-    ndo_meta->blockref = mm.release();
-    return result;
-  */
+  if (reinterpret_cast<uintptr_t>(mm_ptr) % el_tp.get_data_alignment() != 0) {
+    stringstream ss;
+    ss << "cannot memory map file \"" << filename << "\" as type " << tp << " from offset " << begin
+       << ", which is not aligned to " << el_tp.get_data_alignment() << " bytes";
+    throw invalid_argument(ss.str());
+  }
+
+  array res = make_array(res_tp, mm_ptr, mm, access);
+  if (res_tp.get_arrmeta_size() > 0) {
+    res_tp.extended()->arrmeta_default_construct(res->metadata(), true);
+  }
+
+  return res;
+}
+
+nd::array nd::memmap(const std::string &filename, intptr_t begin, intptr_t end, uint32_t access) {
+  return memmap(filename, ndt::make_type<ndt::fixed_dim_kind_type>(ndt::make_type<uint8_t>()), begin, end, access);
 }
 
 nd::array nd::combine_into_tuple(size_t field_count, const array *field_values) {
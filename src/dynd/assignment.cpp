@@ -16,8 +16,9 @@ using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp) {
-  return {dst_tp, src_tp[0]};
+static void func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, ndt::type *res) {
+  res[0] = dst_tp;
+  res[1] = src_tp[0];
 }
 
 template <typename VariadicType, template <typename, typename, VariadicType...> class T>
@@ -72,6 +73,7 @@ nd::callable make_assign() {
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, dynd::string>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, ndt::fixed_string_type>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<bool1, dynd::string>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::categorical_type, ndt::scalar_kind_type>>());
   dispatcher.insert({nd::make_callable<nd::option_to_value_callable>(),
                      nd::make_callable<nd::assign_callable<ndt::option_type, ndt::option_type>>(),
                      nd::make_callable<nd::assignment_option_callable>()});
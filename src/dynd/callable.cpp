@@ -71,6 +71,47 @@ void nd::detail::check_arg(const base_callable *self, intptr_t i, const ndt::typ
   }
 }
 
+void nd::detail::check_kwd(const base_callable *self, intptr_t i, const array &value,
+                           std::map<std::string, ndt::type> &tp_vars) {
+  const std::pair<ndt::type, std::string> &kwd_tp = self->get_kwd_types()[i];
+  ndt::type expected_tp = kwd_tp.first;
+  if (expected_tp.get_id() == option_id) {
+    expected_tp = expected_tp.extended<ndt::option_type>()->get_value_type();
+  }
+
+  const ndt::type &actual_tp = value.get_type();
+  if (!expected_tp.match(actual_tp.value_type(), tp_vars)) {
+    std::stringstream ss;
+    ss << "keyword \"" << kwd_tp.second << "\" does not match, ";
+    ss << "callable expected " << expected_tp << " but passed " << actual_tp;
+    throw std::invalid_argument(ss.str());
+  }
+}
+
+void nd::detail::fill_kwds(const base_callable *self, size_t nkwd, array *kwds,
+                           const std::map<std::string, ndt::type> &tp_vars) {
+  for (intptr_t j : self->get_option_kwd_indices()) {
+    if (kwds[j].is_null()) {
+      ndt::type actual_tp = ndt::substitute(self->get_kwd_types()[j].first, tp_vars, false);
+      if (actual_tp.is_symbolic()) {
+        actual_tp = ndt::make_type<ndt::option_type>(ndt::make_type<void>());
+      }
+      kwds[j] = assign_na({{"dst_tp", actual_tp}});
+      ++nkwd;
+    }
+  }
+
+  if (nkwd < self->get_nkwd()) {
+    std::stringstream ss;
+    // TODO: Provide the missing keyword parameter names in this error
+    //       message
+    ss << "callable requires keyword parameters that were not provided. "
+          "callable signature "
+       << self->get_type();
+    throw std::invalid_argument(ss.str());
+  }
+}
+
 nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
                              const pair<const char *, array> *unordered_kwds) const {
   std::map<std::string, ndt::type> tp_vars;
@@ -114,7 +155,6 @@ nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
 
   array dst;
 
-  const std::vector<std::pair<ndt::type, std::string>> kwd_tp = m_ptr->get_kwd_types();
   for (; j < nkwd; ++j, ++unordered_kwds) {
     intptr_t k = m_ptr->get_kwd_index(unordered_kwds->first);
 
@@ -134,19 +174,7 @@ nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
         throw std::invalid_argument(ss.str());
       }
       value = unordered_kwds->second;
-
-      ndt::type expected_tp = kwd_tp[k].first;
-      if (expected_tp.get_id() == option_id) {
-        expected_tp = expected_tp.extended<ndt::option_type>()->get_value_type();
-      }
-
-      const ndt::type &actual_tp = value.get_type();
-      if (!expected_tp.match(actual_tp.value_type(), tp_vars)) {
-        std::stringstream ss;
-        ss << "keyword \"" << kwd_tp[k].second << "\" does not match, ";
-        ss << "callable expected " << expected_tp << " but passed " << actual_tp;
-        throw std::invalid_argument(ss.str());
-      }
+      detail::check_kwd(m_ptr, k, value, tp_vars);
     }
   }
 
@@ -160,26 +188,10 @@ nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
     }
   }
 
-  for (intptr_t j : m_ptr->get_option_kwd_indices()) {
-    if (kwds[j].is_null()) {
-      ndt::type actual_tp = ndt::substitute(kwd_tp[j].first, tp_vars, false);
-      if (actual_tp.is_symbolic()) {
-        actual_tp = ndt::make_type<ndt::option_type>(ndt::make_type<void>());
-      }
-      kwds[j] = assign_na({{"dst_tp", actual_tp}});
-      ++nkwd;
-    }
-  }
+  detail::fill_kwds(m_ptr, nkwd, kwds.get(), tp_vars);
 
-  if (nkwd < m_ptr->get_nkwd()) {
-    std::stringstream ss;
-    // TODO: Provide the missing keyword parameter names in this error
-    //       message
-    ss << "callable requires keyword parameters that were not provided. "
-          "callable signature "
-       << m_ptr->get_type();
-    throw std::invalid_argument(ss.str());
-  }
+  // Special keywords like "dst" were counted in nkwd, but only the callable's own keywords were stored
+  nkwd = m_ptr->get_nkwd();
 
   ndt::type dst_tp;
   if (dst.is_null()) {
@@ -191,3 +203,24 @@ nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
   m_ptr->call(dst_tp, dst->metadata(), &dst, narg, args_tp.get(), args_arrmeta.get(), args, nkwd, kwds.get(), tp_vars);
   return dst;
 }
+
+nd::prepared_call nd::callable::prepare(const ndt::type &dst_tp, std::initializer_list<ndt::type> src_tp,
+                                        std::initializer_list<array> kwds, kernel_request_t kernreq) const {
+  if (dst_tp.is_symbolic() || dst_tp.get_arrmeta_size() != 0) {
+    std::stringstream ss;
+    ss << "cannot prepare a call without arrmeta for destination type " << dst_tp;
+    throw std::invalid_argument(ss.str());
+  }
+
+  for (const ndt::type &tp : src_tp) {
+    if (tp.get_arrmeta_size() != 0) {
+      std::stringstream ss;
+      ss << "cannot prepare a call without arrmeta for source type " << tp;
+      throw std::invalid_argument(ss.str());
+    }
+  }
+
+  std::vector<const char *> src_arrmeta(src_tp.size(), nullptr);
+  return prepare(dst_tp, nullptr, src_tp.size(), src_tp.begin(), src_arrmeta.data(), kwds.size(), kwds.begin(),
+                 kernreq);
+}
@@ -13,15 +13,18 @@ nd::base_callable::~base_callable() {}
 
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, char *const *src_data, size_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+                                  const std::map<std::string, ndt::type> &tp_vars,
+                                  arena *kernel_arena) {
+  std::shared_ptr<call_cache::entry> e = m_cache.resolve(this, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  dst_tp = e->get_dst_type();
 
   // Allocate the destination array
   array dst = alloc(&dst_tp);
 
-  // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
+  // Generate and evaluate the ckernel, which can't be reused as the arrmeta of dst is new
+  arena &a = (kernel_arena == NULL) ? arena::get() : *kernel_arena;
+  arena::scope scope(a);
+  kernel_builder kb(e->get_call_graph().get(), &a);
   kb(kernel_request_single, nullptr, dst->metadata(), nsrc, src_arrmeta);
 
   kernel_single_t fn = kb.get()->get_function<kernel_single_t>();
@@ -32,15 +35,18 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, const array *src_data, size_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+                                  const std::map<std::string, ndt::type> &tp_vars,
+                                  arena *kernel_arena) {
+  std::shared_ptr<call_cache::entry> e = m_cache.resolve(this, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  dst_tp = e->get_dst_type();
 
   // Allocate the destination array
   array dst = empty(dst_tp);
 
-  // Generate and evaluate the kernel
-  kernel_builder kb(cg.get());
+  // Generate and evaluate the kernel, which can't be reused as the arrmeta of dst is new
+  arena &a = (kernel_arena == NULL) ? arena::get() : *kernel_arena;
+  arena::scope scope(a);
+  kernel_builder kb(e->get_call_graph().get(), &a);
   kb(kernel_request_call, nullptr, dst->metadata(), nsrc, src_arrmeta);
 
   kernel_call_t fn = kb.get()->get_function<kernel_call_t>();
@@ -52,27 +58,27 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data,
                              size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<call_cache::entry> e = m_cache.resolve(this, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
-  // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
-  kb(kernel_request_single, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+  // Generate (or reuse) and evaluate the ckernel
+  call_cache::kernel k = m_cache.instantiate(e, kernel_request_single, dst_arrmeta, nsrc, src_arrmeta);
 
-  kernel_single_t fn = kb.get()->get_function<kernel_single_t>();
-  fn(kb.get(), dst_data, src_data);
+  kernel_single_t fn = k.get()->get_function<kernel_single_t>();
+  fn(k.get(), dst_data, src_data);
+
+  k.release();
 }
 
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, array *dst, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, const array *src, size_t nkwd,
                              const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<call_cache::entry> e = m_cache.resolve(this, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
-  // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
-  kb(kernel_request_call, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+  // Generate (or reuse) and evaluate the ckernel
+  call_cache::kernel k = m_cache.instantiate(e, kernel_request_call, dst_arrmeta, nsrc, src_arrmeta);
 
-  kernel_call_t fn = kb.get()->get_function<kernel_call_t>();
-  fn(kb.get(), dst, src);
+  kernel_call_t fn = k.get()->get_function<kernel_call_t>();
+  fn(k.get(), dst, src);
+
+  k.release();
 }
@@ -0,0 +1,227 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <functional>
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/callables/call_cache.hpp>
+#include <dynd/eval/eval_context.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+size_t hash_combine(size_t seed, size_t value) { return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
+
+size_t hash_type(const ndt::type &tp) {
+  return hash_combine(static_cast<size_t>(tp.get_id()), tp.is_builtin() ? 0 : tp.get_ndim());
+}
+
+/**
+ * Appends the bytes that identify the value of a keyword argument, returning
+ * false if the value can't be compared that way.
+ */
+bool append_kwd_bytes(std::string &bytes, const nd::array &kwd) {
+  if (kwd.is_null()) {
+    bytes.push_back('\0');
+    return true;
+  }
+
+  const ndt::type &tp = kwd.get_type();
+  if (tp.get_data_size() == 0) {
+    bytes.push_back('\1');
+    return true;
+  }
+
+  if (tp.is_pod() && tp.is_c_contiguous(kwd->metadata())) {
+    bytes.push_back('\2');
+    bytes.append(kwd.cdata(), tp.get_data_size());
+    return true;
+  }
+
+  return false;
+}
+
+} // anonymous namespace
+
+std::atomic<size_t> nd::call_cache::s_epoch(0);
+
+void nd::call_cache::kernel::release() {
+  std::lock_guard<std::mutex> lock(m_entry->m_kernel_mutex);
+  m_entry->m_kernel_fingerprint = std::move(m_fingerprint);
+  m_entry->m_kb = std::move(m_kb);
+}
+
+nd::call_cache::entry::entry(size_t hash, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd,
+                             const array *kwds, std::string kwd_bytes)
+    : m_hash(hash), m_dst_tp(dst_tp), m_src_tp(src_tp, src_tp + nsrc), m_kwds(kwds, kwds + nkwd),
+      m_kwd_bytes(std::move(kwd_bytes)), m_epoch(s_epoch), m_last_used(0) {}
+
+bool nd::call_cache::entry::matches(size_t hash, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
+                                    size_t nkwd, const array *kwds, const std::string &kwd_bytes) const {
+  if (m_hash != hash || m_src_tp.size() != nsrc || m_kwds.size() != nkwd || m_kwd_bytes != kwd_bytes ||
+      m_dst_tp != dst_tp) {
+    return false;
+  }
+
+  for (size_t i = 0; i < nsrc; ++i) {
+    if (m_src_tp[i] != src_tp[i]) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < nkwd; ++i) {
+    if (m_kwds[i].is_null() != kwds[i].is_null() ||
+        (!kwds[i].is_null() && m_kwds[i].get_type() != kwds[i].get_type())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+nd::call_cache::call_cache(size_t capacity)
+    : m_capacity(capacity), m_tick(0), m_hits(0), m_misses(0), m_kernel_hits(0), m_kernel_misses(0),
+      m_evictions(0) {}
+
+std::shared_ptr<nd::call_cache::entry> nd::call_cache::resolve(base_callable *self, const ndt::type &dst_tp,
+                                                               size_t nsrc, const ndt::type *src_tp, size_t nkwd,
+                                                               const array *kwds,
+                                                               const std::map<std::string, ndt::type> &tp_vars) {
+  bool cacheable = m_capacity != 0;
+
+  size_t hash = hash_type(dst_tp);
+  for (size_t i = 0; i < nsrc; ++i) {
+    hash = hash_combine(hash, hash_type(src_tp[i]));
+  }
+
+  std::string kwd_bytes;
+  for (size_t i = 0; cacheable && i < nkwd; ++i) {
+    cacheable = append_kwd_bytes(kwd_bytes, kwds[i]);
+    if (!kwds[i].is_null()) {
+      hash = hash_combine(hash, hash_type(kwds[i].get_type()));
+    }
+  }
+  hash = hash_combine(hash, std::hash<std::string>()(kwd_bytes));
+
+  if (cacheable) {
+    size_t epoch = s_epoch;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+      if ((*it)->matches(hash, dst_tp, nsrc, src_tp, nkwd, kwds, kwd_bytes)) {
+        if ((*it)->m_epoch != epoch) {
+          m_entries.erase(it);
+          break;
+        }
+
+        (*it)->m_last_used = ++m_tick;
+        ++m_hits;
+        return *it;
+      }
+    }
+  }
+
+  ++m_misses;
+
+  std::shared_ptr<entry> e = std::make_shared<entry>(hash, dst_tp, nsrc, src_tp, nkwd, kwds, std::move(kwd_bytes));
+  // The call graph may keep the pointers it's resolved with, and is reused by later calls,
+  // so it's resolved with the entry's copies of the signature rather than the caller's
+  e->m_resolved_dst_tp = self->resolve(nullptr, nullptr, e->m_cg, e->m_dst_tp, nsrc, e->m_src_tp.data(), nkwd,
+                                       e->m_kwds.data(), tp_vars);
+
+  if (cacheable) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_capacity != 0) {
+      if (m_entries.size() >= m_capacity) {
+        auto lru = std::min_element(m_entries.begin(), m_entries.end(),
+                                    [](const std::shared_ptr<entry> &lhs, const std::shared_ptr<entry> &rhs) {
+                                      return lhs->m_last_used < rhs->m_last_used;
+                                    });
+        m_entries.erase(lru);
+        ++m_evictions;
+      }
+
+      e->m_last_used = ++m_tick;
+      m_entries.push_back(e);
+    }
+  }
+
+  return e;
+}
+
+nd::call_cache::kernel nd::call_cache::instantiate(const std::shared_ptr<entry> &e, kernel_request_t kernreq,
+                                                   const char *dst_arrmeta, size_t nsrc,
+                                                   const char *const *src_arrmeta) {
+  // The fingerprint is the kernel request, the threading settings that elwise
+  // kernels are built with, then the address and contents of every arrmeta
+  std::string fingerprint(reinterpret_cast<const char *>(&kernreq), sizeof(kernreq));
+  fingerprint.append(reinterpret_cast<const char *>(&eval::default_eval_context.nthreads),
+                     sizeof(eval::default_eval_context.nthreads));
+  fingerprint.append(reinterpret_cast<const char *>(&eval::default_eval_context.grain_size),
+                     sizeof(eval::default_eval_context.grain_size));
+  fingerprint.append(reinterpret_cast<const char *>(&dst_arrmeta), sizeof(dst_arrmeta));
+  if (dst_arrmeta != nullptr) {
+    fingerprint.append(dst_arrmeta, e->m_resolved_dst_tp.get_arrmeta_size());
+  }
+  for (size_t i = 0; i < nsrc; ++i) {
+    fingerprint.append(reinterpret_cast<const char *>(&src_arrmeta[i]), sizeof(src_arrmeta[i]));
+    if (src_arrmeta[i] != nullptr) {
+      fingerprint.append(src_arrmeta[i], e->m_src_tp[i].get_arrmeta_size());
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(e->m_kernel_mutex);
+    if (e->m_kb != nullptr && e->m_kernel_fingerprint == fingerprint) {
+      ++m_kernel_hits;
+      return kernel(e, std::move(e->m_kb), std::move(fingerprint));
+    }
+  }
+
+  ++m_kernel_misses;
+
+  std::unique_ptr<kernel_builder> kb(new kernel_builder(e->m_cg.get()));
+  (*kb)(kernreq, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+
+  return kernel(e, std::move(kb), std::move(fingerprint));
+}
+
+void nd::call_cache::set_capacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_capacity = capacity;
+  while (m_entries.size() > m_capacity) {
+    auto lru = std::min_element(m_entries.begin(), m_entries.end(),
+                                [](const std::shared_ptr<entry> &lhs, const std::shared_ptr<entry> &rhs) {
+                                  return lhs->m_last_used < rhs->m_last_used;
+                                });
+    m_entries.erase(lru);
+    ++m_evictions;
+  }
+}
+
+size_t nd::call_cache::size() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+void nd::call_cache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+nd::call_cache_stats nd::call_cache::get_stats() const {
+  return call_cache_stats{m_hits, m_misses, m_kernel_hits, m_kernel_misses, m_evictions};
+}
+
+void nd::call_cache::reset_stats() {
+  m_hits = 0;
+  m_misses = 0;
+  m_kernel_hits = 0;
+  m_kernel_misses = 0;
+  m_evictions = 0;
+}
@@ -0,0 +1,56 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/callable.hpp>
+#include <dynd/callables/prepared_call.hpp>
+
+using namespace std;
+using namespace dynd;
+
+nd::prepared_call::prepared_call(base_callable *self, const ndt::type &dst_tp, const char *dst_arrmeta, size_t nsrc,
+                                 const ndt::type *src_tp, const char *const *src_arrmeta, size_t nkwd,
+                                 const array *kwds, kernel_request_t kernreq)
+    : m_kernreq(kernreq) {
+  if (kernreq != kernel_request_single && kernreq != kernel_request_strided) {
+    throw invalid_argument("a prepared call requires kernel_request_single or kernel_request_strided, got " +
+                           to_string(kernreq));
+  }
+
+  // The signature is checked and the missing option keywords filled in as callable::call does
+  std::map<std::string, ndt::type> tp_vars;
+  detail::check_narg(self, nsrc);
+  for (size_t i = 0; i < nsrc; ++i) {
+    detail::check_arg(self, i, src_tp[i], src_arrmeta[i], tp_vars);
+  }
+
+  if (nkwd > self->get_nkwd()) {
+    std::stringstream ss;
+    ss << "callable expected at most " << self->get_nkwd() << " keyword arguments, but received " << nkwd;
+    throw invalid_argument(ss.str());
+  }
+  std::vector<array> all_kwds(kwds, kwds + nkwd);
+  all_kwds.resize(self->get_nkwd());
+  size_t ngiven = 0;
+  for (size_t i = 0; i < nkwd; ++i) {
+    if (!kwds[i].is_null()) {
+      detail::check_kwd(self, i, kwds[i], tp_vars);
+      ++ngiven;
+    }
+  }
+
+  if (!self->get_ret_type().match(dst_tp, tp_vars)) {
+    std::stringstream ss;
+    ss << "destination type " << dst_tp << " does not match callable return type " << self->get_ret_type();
+    throw invalid_argument(ss.str());
+  }
+
+  detail::fill_kwds(self, ngiven, all_kwds.data(), tp_vars);
+
+  // The resolution is shared with the callable's call cache
+  m_entry = self->get_call_cache().resolve(self, dst_tp, nsrc, src_tp, all_kwds.size(), all_kwds.data(), tp_vars);
+
+  m_kb.reset(new kernel_builder(m_entry->get_call_graph().get()));
+  (*m_kb)(kernreq, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+}
@@ -173,6 +173,10 @@ nd::callable nd::functional::neighborhood(const callable &neighborhood_op, const
 }
 
 nd::callable nd::functional::reduction(const callable &identity, const callable &child) {
+  return reduction(identity, child, callable());
+}
+
+nd::callable nd::functional::reduction(const callable &identity, const callable &child, const callable &combiner) {
   if (identity.is_null()) {
     throw invalid_argument("'identity' cannot be null");
   }
@@ -189,11 +193,13 @@ nd::callable nd::functional::reduction(const callable &identity, const callable
   std::vector<std::pair<ndt::type, std::string>> kwds{
       {ndt::make_type<ndt::option_type>(ndt::type("Fixed * int32")), "axes"},
       {ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "keepdims"}};
+  // Keywords of the child follow the reduction's own, and are forwarded to it
+  kwds.insert(kwds.end(), child->get_kwd_types().begin(), child->get_kwd_types().end());
 
   return make_callable<reduction_dispatch_callable>(
       ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::ellipsis_dim_type>("Dims", child->get_ret_type()),
                                          arg_tp.size(), arg_tp.data(), kwds),
-      identity, child);
+      identity, child, combiner);
 }
 
 nd::callable nd::functional::where(const callable &child) { return elwise(make_callable<where_callable>(child), true); }
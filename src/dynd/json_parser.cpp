@@ -3,14 +3,30 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <random>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include <dynd/callable.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/json_structural_index.hpp>
 #include <dynd/kernels/parse_kernel.hpp>
 #include <dynd/parse.hpp>
+#include <dynd/thread_pool.hpp>
 #include <dynd/types/base_bytes_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/tuple_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
 using namespace std;
@@ -74,115 +90,149 @@ nd::array dynd::parse_json(const ndt::type &tp, const nd::array &json, const eva
   return parse_json(tp, json_begin, json_end, ectx);
 }
 
-static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&json_begin,
-                       const char *json_end, const eval::eval_context *ectx);
+namespace {
+
+/**
+ * A position in the structural index of a JSON document. The functions below step
+ * through the brackets, braces, colons and commas of the document by their indexed
+ * positions, and hand the text of each scalar value, which runs up to the next
+ * structural character, to the scalar parsers.
+ */
+struct json_cursor {
+  const char *begin;
+  const char *end;
+  const size_t *it;
+
+  json_cursor(const json::structural_index &index, size_t i = 0)
+      : begin(index.get_begin()), end(index.get_end()), it(index.positions() + i) {}
 
-static void skip_json_value(const char *&begin, const char *end) {
+  // The current structural character, or the end of the document
+  const char *pos() const { return begin + *it; }
+
+  bool at_end() const { return pos() == end; }
+
+  // The end of the text of the value starting at the current structural character
+  const char *value_end() const { return at_end() ? end : begin + it[1]; }
+
+  bool parse_token(char token) {
+    if (!at_end() && *pos() == token) {
+      ++it;
+      return true;
+    }
+    return false;
+  }
+};
+
+} // anonymous namespace
+
+static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                       const eval::eval_context *ectx);
+
+/**
+ * Parses the string at the cursor, stepping past it. Returns false if there's
+ * no string there.
+ */
+static bool parse_json_string(json_cursor &cur, const char *&strbegin, const char *&strend, bool &escaped) {
+  const char *begin = cur.pos(), *end = cur.value_end();
+  if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
+    return false;
+  }
   skip_whitespace(begin, end);
-  if (begin == end) {
-    throw parse_error(begin, "malformed JSON, expecting an element");
+  if (begin != end) {
+    return false;
   }
-  char c = *begin;
-  switch (c) {
+  ++cur.it;
+  return true;
+}
+
+static void skip_json_value(json_cursor &cur) {
+  if (cur.at_end()) {
+    throw parse_error(cur.pos(), "malformed JSON, expecting an element");
+  }
+  const char *strbegin, *strend;
+  bool escaped;
+  switch (*cur.pos()) {
   // Object
   case '{':
-    ++begin;
-    if (!parse_token(begin, end, "}")) {
+    ++cur.it;
+    if (!cur.parse_token('}')) {
       for (;;) {
-        const char *strbegin, *strend;
-        bool escaped;
-        skip_whitespace(begin, end);
-        if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
-          throw parse_error(begin, "expected string for name in object dict");
+        if (!parse_json_string(cur, strbegin, strend, escaped)) {
+          throw parse_error(cur.pos(), "expected string for name in object dict");
         }
-        if (!parse_token(begin, end, ":")) {
-          throw parse_error(begin, "expected ':' separating name from value in object dict");
+        if (!cur.parse_token(':')) {
+          throw parse_error(cur.pos(), "expected ':' separating name from value in object dict");
         }
-        skip_json_value(begin, end);
-        if (!parse_token(begin, end, ",")) {
+        skip_json_value(cur);
+        if (!cur.parse_token(',')) {
           break;
         }
       }
-      if (!parse_token(begin, end, "}")) {
-        throw parse_error(begin, "expected object separator ',' or terminator '}'");
+      if (!cur.parse_token('}')) {
+        throw parse_error(cur.pos(), "expected object separator ',' or terminator '}'");
       }
     }
     break;
   // Array
   case '[':
-    ++begin;
-    if (!parse_token(begin, end, "]")) {
+    ++cur.it;
+    if (!cur.parse_token(']')) {
       for (;;) {
-        skip_json_value(begin, end);
-        if (!parse_token(begin, end, ",")) {
+        skip_json_value(cur);
+        if (!cur.parse_token(',')) {
           break;
         }
       }
-      if (!parse_token(begin, end, "]")) {
-        throw parse_error(begin, "expected array separator ',' or terminator ']'");
+      if (!cur.parse_token(']')) {
+        throw parse_error(cur.pos(), "expected array separator ',' or terminator ']'");
       }
     }
     break;
-  case '"': {
-    const char *strbegin, *strend;
-    bool escaped;
-    if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
-      throw parse_error(begin, "invalid string");
-    }
-    break;
-  }
-  case 't':
-    if (!parse_token(begin, end, "true")) {
-      throw parse_error(begin, "invalid json value");
-    }
-    break;
-  case 'f':
-    if (!parse_token(begin, end, "false")) {
-      throw parse_error(begin, "invalid json value");
+  case '"':
+    if (!parse_json_string(cur, strbegin, strend, escaped)) {
+      throw parse_error(cur.pos(), "invalid string");
     }
     break;
-  case 'n':
-    if (!parse_token(begin, end, "null")) {
+  default: {
+    const char *begin = cur.pos(), *end = cur.value_end();
+    if (!parse_token(begin, end, "true") && !parse_token(begin, end, "false") && !parse_token(begin, end, "null") &&
+        !json::parse_number(begin, end, strbegin, strend)) {
       throw parse_error(begin, "invalid json value");
     }
-    break;
-  default:
-    if (c == '-' || ('0' <= c && c <= '9')) {
-      const char *nbegin = NULL, *nend = NULL;
-      if (!json::parse_number(begin, end, nbegin, nend)) {
-        throw parse_error(begin, "invalid number");
-      }
-    } else {
+    skip_whitespace(begin, end);
+    if (begin != end) {
       throw parse_error(begin, "invalid json value");
     }
+    ++cur.it;
+  }
   }
 }
 
-static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                   const char *end, const eval::eval_context *ectx) {
+static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                                   const eval::eval_context *ectx) {
   intptr_t dim_size, stride;
   ndt::type el_tp;
   const char *el_arrmeta;
   if (!tp.get_as_strided(arrmeta, &dim_size, &stride, &el_tp, &el_arrmeta)) {
-    throw json_parse_error(begin, "expected a strided dimension", tp);
+    throw json_parse_error(cur.pos(), "expected a strided dimension", tp);
   }
 
-  if (!parse_token(begin, end, "[")) {
-    throw json_parse_error(begin, "expected list starting with '['", tp);
+  if (!cur.parse_token('[')) {
+    throw json_parse_error(cur.pos(), "expected list starting with '['", tp);
   }
   for (intptr_t i = 0; i < dim_size; ++i) {
-    parse_json(el_tp, el_arrmeta, out_data + i * stride, begin, end, ectx);
-    if (i < dim_size - 1 && !parse_token(begin, end, ",")) {
-      throw json_parse_error(begin, "array is too short, expected ',' list item separator", tp);
+    parse_json(el_tp, el_arrmeta, out_data + i * stride, cur, ectx);
+    if (i < dim_size - 1 && !cur.parse_token(',')) {
+      throw json_parse_error(cur.pos(), "array is too short, expected ',' list item separator", tp);
     }
   }
-  if (!parse_token(begin, end, "]")) {
-    throw json_parse_error(begin, "array is too long, expected list terminator ']'", tp);
+  if (!cur.parse_token(']')) {
+    throw json_parse_error(cur.pos(), "array is too long, expected list terminator ']'", tp);
   }
 }
 
-static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                               const char *end, const eval::eval_context *ectx) {
+static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                               const eval::eval_context *ectx) {
   const ndt::var_dim_type *vad = tp.extended<ndt::var_dim_type>();
   const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
   intptr_t stride = md->stride;
@@ -193,11 +243,11 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
   intptr_t size = 0, allocated_size = 8;
   out->begin = md->blockref->alloc(allocated_size);
 
-  if (!parse_token(begin, end, "[")) {
-    throw json_parse_error(begin, "expected array starting with '['", tp);
+  if (!cur.parse_token('[')) {
+    throw json_parse_error(cur.pos(), "expected array starting with '['", tp);
   }
   // If it's not an empty list, start the loop parsing the elements
-  if (!parse_token(begin, end, "]")) {
+  if (!cur.parse_token(']')) {
     for (;;) {
       // Increase the allocated array size if necessary
       if (size == allocated_size) {
@@ -207,13 +257,13 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
       ++size;
       out->size = size;
       parse_json(element_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type), out->begin + (size - 1) * stride,
-                 begin, end, ectx);
-      if (!parse_token(begin, end, ",")) {
+                 cur, ectx);
+      if (!cur.parse_token(',')) {
         break;
       }
     }
-    if (!parse_token(begin, end, "]")) {
-      throw json_parse_error(begin, "expected array separator ',' or terminator ']'", tp);
+    if (!cur.parse_token(']')) {
+      throw json_parse_error(cur.pos(), "expected array separator ',' or terminator ']'", tp);
     }
   }
 
@@ -222,10 +272,10 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
   out->size = size;
 }
 
-static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                          const char *end, const eval::eval_context *ectx) {
-  const char *saved_begin = begin;
-  if (!parse_token(begin, end, "{")) {
+static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                                          const eval::eval_context *ectx) {
+  const char *saved_begin = cur.pos();
+  if (!cur.parse_token('{')) {
     return false;
   }
 
@@ -239,16 +289,15 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
   memset(populated_fields.get(), 0, sizeof(bool) * field_count);
 
   // If it's not an empty object, start the loop parsing the elements
-  if (!parse_token(begin, end, "}")) {
+  if (!cur.parse_token('}')) {
     for (;;) {
       const char *strbegin, *strend;
       bool escaped;
-      skip_whitespace(begin, end);
-      if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
-        throw json_parse_error(begin, "expected string for name in object dict", tp);
+      if (!parse_json_string(cur, strbegin, strend, escaped)) {
+        throw json_parse_error(cur.pos(), "expected string for name in object dict", tp);
       }
-      if (!parse_token(begin, end, ":")) {
-        throw json_parse_error(begin, "expected ':' separating name from value in object dict", tp);
+      if (!cur.parse_token(':')) {
+        throw json_parse_error(cur.pos(), "expected ':' separating name from value in object dict", tp);
       }
       intptr_t i;
       if (escaped) {
@@ -256,22 +305,22 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
         unescape_string(strbegin, strend, name);
         i = fsd->get_field_index(name);
       } else {
-        i = fsd->get_field_index(std::string(strbegin, strend));
+        i = fsd->get_field_index(strbegin, strend - strbegin);
       }
       if (i == -1) {
         // TODO: Add an error policy to this parser of whether to throw an error
         //       or not. For now, just throw away fields not in the destination.
-        skip_json_value(begin, end);
+        skip_json_value(cur);
       } else {
-        parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, ectx);
+        parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], cur, ectx);
         populated_fields[i] = true;
       }
-      if (!parse_token(begin, end, ",")) {
+      if (!cur.parse_token(',')) {
         break;
       }
     }
-    if (!parse_token(begin, end, "}")) {
-      throw json_parse_error(begin, "expected object dict separator ',' or terminator '}'", tp);
+    if (!cur.parse_token('}')) {
+      throw json_parse_error(cur.pos(), "expected object dict separator ',' or terminator '}'", tp);
     }
   }
 
@@ -285,7 +334,6 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
         ss << "object dict does not contain the field ";
         print_escaped_utf8_string(ss, fsd->get_field_name(i));
         ss << " as required by the data type";
-        skip_whitespace(saved_begin, end);
         throw json_parse_error(saved_begin, ss.str(), tp);
       }
     }
@@ -295,9 +343,9 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
 }
 
 template <class Type>
-static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                       const char *end, const eval::eval_context *ectx) {
-  if (!parse_token(begin, end, "[")) {
+static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                                       const eval::eval_context *ectx) {
+  if (!cur.parse_token('[')) {
     return false;
   }
 
@@ -308,34 +356,33 @@ static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta,
 
   // Loop through all the fields
   for (intptr_t i = 0; i != field_count; ++i) {
-    skip_whitespace(begin, end);
-    parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, ectx);
-    if (i != field_count - 1 && !parse_token(begin, end, ",")) {
-      throw json_parse_error(begin, "expected list item separator ','", tp);
+    parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], cur, ectx);
+    if (i != field_count - 1 && !cur.parse_token(',')) {
+      throw json_parse_error(cur.pos(), "expected list item separator ','", tp);
     }
   }
 
-  if (!parse_token(begin, end, "]")) {
-    throw json_parse_error(begin, "expected end of list ']'", tp);
+  if (!cur.parse_token(']')) {
+    throw json_parse_error(cur.pos(), "expected end of list ']'", tp);
   }
 
   return true;
 }
 
-static void parse_struct_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                              const char *end, const eval::eval_context *ectx) {
-  if (parse_struct_json_from_object(tp, arrmeta, out_data, begin, end, ectx)) {
-  } else if (parse_tuple_json_from_list<ndt::struct_type>(tp, arrmeta, out_data, begin, end, ectx)) {
+static void parse_struct_json(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                              const eval::eval_context *ectx) {
+  if (parse_struct_json_from_object(tp, arrmeta, out_data, cur, ectx)) {
+  } else if (parse_tuple_json_from_list<ndt::struct_type>(tp, arrmeta, out_data, cur, ectx)) {
   } else {
-    throw json_parse_error(begin, "expected object dict starting with '{' or list with '['", tp);
+    throw json_parse_error(cur.pos(), "expected object dict starting with '{' or list with '['", tp);
   }
 }
 
-static void parse_tuple_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                             const char *end, const eval::eval_context *ectx) {
-  if (parse_tuple_json_from_list<ndt::tuple_type>(tp, arrmeta, out_data, begin, end, ectx)) {
+static void parse_tuple_json(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                             const eval::eval_context *ectx) {
+  if (parse_tuple_json_from_list<ndt::tuple_type>(tp, arrmeta, out_data, cur, ectx)) {
   } else {
-    throw json_parse_error(begin, "expected object dict starting with '{' or list with '['", tp);
+    throw json_parse_error(cur.pos(), "expected object dict starting with '{' or list with '['", tp);
   }
 }
 
@@ -468,14 +515,14 @@ static void parse_type(const ndt::type &tp, const char *DYND_UNUSED(arrmeta), ch
   rbegin = begin;
 }
 
-static void parse_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                           const char *end, const eval::eval_context *ectx) {
+static void parse_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
+                           const eval::eval_context *ectx) {
   switch (tp.get_id()) {
   case fixed_dim_id:
-    parse_strided_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_strided_dim_json(tp, arrmeta, out_data, cur, ectx);
     break;
   case var_dim_id:
-    parse_var_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_var_dim_json(tp, arrmeta, out_data, cur, ectx);
     break;
   default: {
     stringstream ss;
@@ -548,23 +595,30 @@ static void parse_option_json(const ndt::type &tp, const char *arrmeta, char *ou
   throw runtime_error(ss.str());
 }
 
-static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin, const char *end,
+static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, json_cursor &cur,
                        const eval::eval_context *ectx) {
-  skip_whitespace(begin, end);
   switch (tp.get_id()) {
   case fixed_dim_id:
   case var_dim_id:
-    parse_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_dim_json(tp, arrmeta, out_data, cur, ectx);
     return;
   case struct_id:
-    parse_struct_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_struct_json(tp, arrmeta, out_data, cur, ectx);
     return;
   case tuple_id:
-    parse_tuple_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_tuple_json(tp, arrmeta, out_data, cur, ectx);
     return;
+  default:
+    break;
+  }
+
+  // The remaining types are scalars, whose text runs up to the next structural character
+  const char *begin = cur.pos(), *end = cur.value_end();
+  skip_whitespace(begin, end);
+  switch (tp.get_id()) {
   case bool_id:
     parse_bool_json(tp, arrmeta, out_data, begin, end, false, ectx);
-    return;
+    break;
   case int8_id:
   case int16_id:
   case int32_id:
@@ -582,24 +636,31 @@ static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data,
   case complex_float32_id:
   case complex_float64_id:
     parse_number_json(tp, out_data, begin, end, false, ectx);
-    return;
+    break;
   case fixed_string_id:
   case string_id:
     parse_string_json(tp, arrmeta, out_data, begin, end, ectx);
-    return;
+    break;
   case type_id:
     parse_type(tp, arrmeta, out_data, begin, end, false, ectx);
-    return;
+    break;
   case option_id:
     parse_option_json(tp, arrmeta, out_data, begin, end, ectx);
-    return;
-  default:
     break;
+  default: {
+    stringstream ss;
+    ss << "parse_json: unsupported dynd type \"" << tp << "\"";
+    throw runtime_error(ss.str());
+  }
   }
 
-  stringstream ss;
-  ss << "parse_json: unsupported dynd type \"" << tp << "\"";
-  throw runtime_error(ss.str());
+  skip_whitespace(begin, end);
+  if (begin != end) {
+    throw json_parse_error(begin, "unexpected text after the value", tp);
+  }
+  if (!cur.at_end()) {
+    ++cur.it;
+  }
 }
 
 /**
@@ -668,11 +729,11 @@ void print_json_parse_error_marker(std::ostream &o, const std::string &line_prev
 
 void dynd::validate_json(const char *json_begin, const char *json_end) {
   try {
-    const char *begin = json_begin, *end = json_end;
-    ::skip_json_value(begin, end);
-    skip_whitespace(begin, end);
-    if (begin != end) {
-      throw parse_error(begin, "unexpected trailing JSON text");
+    json::structural_index index(json_begin, json_end);
+    json_cursor cur(index);
+    ::skip_json_value(cur);
+    if (!cur.at_end()) {
+      throw parse_error(cur.pos(), "unexpected trailing JSON text");
     }
   } catch (const parse_error &e) {
     stringstream ss;
@@ -686,14 +747,227 @@ void dynd::validate_json(const char *json_begin, const char *json_end) {
   }
 }
 
-void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx) {
+namespace {
+
+// The least amount of JSON text worth giving a thread of its own
+const size_t json_parallel_grain_size = 1 << 16;
+
+// How many pieces the work of each thread is cut into, so threads that finish early
+// can take over pieces from the others
+const size_t json_chunks_per_thread = 4;
+
+} // anonymous namespace
+
+/**
+ * The number of threads to split ``size`` bytes of JSON among, which is more than
+ * one only when the evaluation context allows it and there's enough text. The
+ * thread pool runs the pieces on as many of them as it has.
+ */
+static size_t json_parse_nthreads(const eval::eval_context *ectx, size_t size) {
+  if (ectx->nthreads <= 1 || thread_pool::in_task()) {
+    return 1;
+  }
+
+  return std::min(ectx->nthreads, size / json_parallel_grain_size);
+}
+
+/**
+ * Makes arrmeta for elements of type ``tp`` whose var dims allocate from memory blocks
+ * of their own, so that a thread can parse elements into it while others use theirs.
+ * The arrmeta is after a fixed_dim_type_arrmeta in the result.
+ */
+static nd::array make_chunk_arrmeta(const ndt::type &tp) { return nd::empty(ndt::make_fixed_dim(0, tp)); }
+
+/**
+ * Has the memory blocks of the var dims in ``dst_arrmeta`` take over the memory that
+ * was allocated from the ones in ``src_arrmeta``, both being arrmeta for type ``tp``.
+ */
+static void absorb_buffers(const ndt::type &tp, const char *dst_arrmeta, const char *src_arrmeta) {
+  switch (tp.get_id()) {
+  case var_dim_id: {
+    const ndt::var_dim_type::metadata_type *dst_md =
+        reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta);
+    const ndt::var_dim_type::metadata_type *src_md =
+        reinterpret_cast<const ndt::var_dim_type::metadata_type *>(src_arrmeta);
+    dst_md->blockref->absorb(*src_md->blockref);
+    absorb_buffers(tp.extended<ndt::var_dim_type>()->get_element_type(),
+                   dst_arrmeta + sizeof(ndt::var_dim_type::metadata_type),
+                   src_arrmeta + sizeof(ndt::var_dim_type::metadata_type));
+    break;
+  }
+  case fixed_dim_id:
+    absorb_buffers(tp.extended<ndt::fixed_dim_type>()->get_element_type(), dst_arrmeta + sizeof(fixed_dim_type_arrmeta),
+                   src_arrmeta + sizeof(fixed_dim_type_arrmeta));
+    break;
+  case struct_id: {
+    const ndt::struct_type *st = tp.extended<ndt::struct_type>();
+    const std::vector<uintptr_t> &offsets = st->get_arrmeta_offsets();
+    for (intptr_t i = 0; i < st->get_field_count(); ++i) {
+      absorb_buffers(st->get_field_type(i), dst_arrmeta + offsets[i], src_arrmeta + offsets[i]);
+    }
+    break;
+  }
+  case tuple_id: {
+    const ndt::tuple_type *tt = tp.extended<ndt::tuple_type>();
+    const std::vector<uintptr_t> &offsets = tt->get_arrmeta_offsets();
+    for (intptr_t i = 0; i < tt->get_field_count(); ++i) {
+      absorb_buffers(tt->get_field_type(i), dst_arrmeta + offsets[i], src_arrmeta + offsets[i]);
+    }
+    break;
+  }
+  case option_id:
+    absorb_buffers(tp.extended<ndt::option_type>()->get_value_type(), dst_arrmeta, src_arrmeta);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Finds where each element of a document that's a single array starts, as indices
+ * of structural characters. Returns false if the document isn't a single array with
+ * matching brackets, leaving its errors for the serial parser to report.
+ */
+static bool split_json_array(const json::structural_index &index, std::vector<size_t> &out_starts) {
+  const char *begin = index.get_begin();
+  const size_t *positions = index.positions();
+  size_t size = index.size();
+  if (size < 2 || begin[positions[0]] != '[' || begin[positions[size - 1]] != ']') {
+    return false;
+  }
+  if (size == 2) {
+    return true;
+  }
+
+  out_starts.push_back(1);
+  // The closing brackets of the arrays and objects the elements are nested in
+  std::vector<char> closing;
+  for (size_t i = 1; i < size - 1; ++i) {
+    switch (begin[positions[i]]) {
+    case '[':
+      closing.push_back(']');
+      break;
+    case '{':
+      closing.push_back('}');
+      break;
+    case ']':
+    case '}':
+      if (closing.empty() || closing.back() != begin[positions[i]]) {
+        return false;
+      }
+      closing.pop_back();
+      break;
+    case ',':
+      if (closing.empty()) {
+        out_starts.push_back(i + 1);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  return closing.empty();
+}
+
+/**
+ * Parses a document that's a single array into a fixed or var dim, splitting its
+ * elements into chunks that are parsed on the thread pool. The var dims inside the
+ * elements of each chunk allocate from the chunk's own memory blocks, which are
+ * handed over to the result's memory blocks at the end, so nothing is copied.
+ * Returns false, having done nothing, if the document isn't worth splitting.
+ */
+static bool parse_json_array_parallel(const ndt::type &tp, const char *arrmeta, char *out_data,
+                                      const json::structural_index &index, const eval::eval_context *ectx) {
+  if (tp.get_id() != var_dim_id && tp.get_id() != fixed_dim_id) {
+    return false;
+  }
+  size_t nthreads = json_parse_nthreads(ectx, index.get_end() - index.get_begin());
+  if (nthreads <= 1) {
+    return false;
+  }
+  std::vector<size_t> starts;
+  if (!split_json_array(index, starts) || starts.size() < 2) {
+    return false;
+  }
+  size_t size = starts.size();
+
+  const ndt::type &element_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+  const char *element_arrmeta;
+  intptr_t stride;
+  char *element_data;
+  if (tp.get_id() == var_dim_id) {
+    const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+    ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(out_data);
+    out->begin = md->blockref->alloc(size);
+    out->size = size;
+    element_arrmeta = arrmeta + sizeof(ndt::var_dim_type::metadata_type);
+    stride = md->stride;
+    element_data = out->begin;
+  } else {
+    const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+    if (static_cast<size_t>(md->dim_size) != size) {
+      return false;
+    }
+    element_arrmeta = arrmeta + sizeof(fixed_dim_type_arrmeta);
+    stride = md->stride;
+    element_data = out_data;
+  }
+
+  size_t nchunks = std::min(size, nthreads * json_chunks_per_thread);
+  std::vector<nd::array> chunk_arrmeta;
+  if (element_tp.get_arrmeta_size() > 0) {
+    for (size_t chunk = 0; chunk < nchunks; ++chunk) {
+      chunk_arrmeta.push_back(make_chunk_arrmeta(element_tp));
+    }
+  }
+
+  try {
+    thread_pool::get().run(nthreads, nchunks, [&](size_t chunk, size_t DYND_UNUSED(thread)) {
+      const char *arrmeta =
+          chunk_arrmeta.empty() ? element_arrmeta : chunk_arrmeta[chunk].get()->metadata() + sizeof(fixed_dim_type_arrmeta);
+      size_t first = chunk * size / nchunks, last = (chunk + 1) * size / nchunks;
+      json_cursor cur(index, starts[first]);
+      for (size_t i = first; i < last; ++i) {
+        ::parse_json(element_tp, arrmeta, element_data + i * stride, cur, ectx);
+        // Each element is followed by the ',' before the next one, or by the final ']'
+        size_t next = (i + 1 < size) ? starts[i + 1] - 1 : index.size() - 1;
+        if (static_cast<size_t>(cur.it - index.positions()) != next) {
+          throw json_parse_error(cur.pos(), "expected array separator ',' or terminator ']'", tp);
+        }
+        ++cur.it;
+      }
+    });
+  } catch (...) {
+    // Whatever was parsed refers to the memory of the chunks
+    for (const nd::array &a : chunk_arrmeta) {
+      absorb_buffers(element_tp, element_arrmeta, a.get()->metadata() + sizeof(fixed_dim_type_arrmeta));
+    }
+    throw;
+  }
+  for (const nd::array &a : chunk_arrmeta) {
+    absorb_buffers(element_tp, element_arrmeta, a.get()->metadata() + sizeof(fixed_dim_type_arrmeta));
+  }
+
+  return true;
+}
+
+/**
+ * Parses a JSON document into ``out``. When ``parallel`` is true, ``out`` must have
+ * been allocated by ``nd::empty``, so the layout of its arrmeta is the default one,
+ * and a document that's a large array may then be parsed on several threads.
+ */
+static void parse_json_document(nd::array &out, const char *json_begin, const char *json_end,
+                                const eval::eval_context *ectx, bool parallel) {
   try {
-    const char *begin = json_begin, *end = json_end;
+    json::structural_index index(json_begin, json_end);
     ndt::type tp = out.get_type();
-    ::parse_json(tp, out.get()->metadata(), out.data(), begin, end, ectx);
-    skip_whitespace(begin, end);
-    if (begin != end) {
-      throw json_parse_error(begin, "unexpected trailing JSON text", tp);
+    if (!parallel || !parse_json_array_parallel(tp, out.get()->metadata(), out.data(), index, ectx)) {
+      json_cursor cur(index);
+      ::parse_json(tp, out.get()->metadata(), out.data(), cur, ectx);
+      if (!cur.at_end()) {
+        throw json_parse_error(cur.pos(), "unexpected trailing JSON text", tp);
+      }
     }
   } catch (const json_parse_error &e) {
     stringstream ss;
@@ -717,149 +991,513 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
   }
 }
 
+void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx) {
+  parse_json_document(out, json_begin, json_end, ectx, false);
+}
+
 nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const char *json_end,
                            const eval::eval_context *ectx) {
   nd::array result;
   result = nd::empty(tp);
-  parse_json(result, json_begin, json_end, ectx);
+  parse_json_document(result, json_begin, json_end, ectx, true);
   if (!tp.is_builtin()) {
     tp.extended()->arrmeta_finalize_buffers(result.get()->metadata());
   }
   return result;
 }
 
-/*
-static ndt::type discover_type(const char *&begin, const char *end)
-{
-  skip_whitespace(begin, end);
-  if (begin == end) {
-    throw parse_error(begin, "malformed JSON, expecting an element");
+nd::json::ndjson_reader::ndjson_reader(std::istream &stream, const ndt::type &record_tp, intptr_t batch_size,
+                                       const eval::eval_context *ectx)
+    : m_stream(&stream), m_fd(-1), m_record_tp(record_tp), m_batch_size(batch_size), m_ectx(*ectx) {
+  init();
+}
+
+nd::json::ndjson_reader::ndjson_reader(int fd, const ndt::type &record_tp, intptr_t batch_size,
+                                       const eval::eval_context *ectx)
+    : m_stream(NULL), m_fd(fd), m_record_tp(record_tp), m_batch_size(batch_size), m_ectx(*ectx) {
+  init();
+}
+
+void nd::json::ndjson_reader::init() {
+  if (m_batch_size <= 0) {
+    stringstream ss;
+    ss << "ndjson_reader: the batch size must be positive, got " << m_batch_size;
+    throw invalid_argument(ss.str());
   }
-  char c = *begin;
-  switch (c) {
-  // Object
-  case '{': {
-    ++begin;
-    if (parse_token(begin, end, "}")) {
-      return ndt::struct_type::make();
+
+  m_batch = nd::empty(ndt::make_fixed_dim(m_batch_size, m_record_tp));
+  m_buffer.resize(1 << 20);
+  m_buffer_begin = 0;
+  m_buffer_end = 0;
+  m_batch_text = 0;
+  m_eof = false;
+  m_line = 0;
+  m_indexes.resize(1);
+}
+
+size_t nd::json::ndjson_reader::read_some(char *data, size_t size) {
+  if (m_stream != NULL) {
+    m_stream->read(data, size);
+    if (m_stream->bad()) {
+      throw runtime_error("ndjson_reader: error reading from the stream");
     }
-    std::vector<std::string> names;
+    return static_cast<size_t>(m_stream->gcount());
+  }
+
+  for (;;) {
+#ifdef WIN32
+    int count = ::_read(m_fd, data, static_cast<unsigned int>(std::min<size_t>(size, INT_MAX)));
+#else
+    ssize_t count = ::read(m_fd, data, size);
+#endif
+    if (count >= 0) {
+      return static_cast<size_t>(count);
+    } else if (errno != EINTR) {
+      stringstream ss;
+      ss << "ndjson_reader: error reading from file descriptor " << m_fd << ": " << strerror(errno);
+      throw runtime_error(ss.str());
+    }
+  }
+}
+
+bool nd::json::ndjson_reader::next_line(size_t &begin, size_t &end) {
+  for (;;) {
+    char *data = m_buffer.data();
+    const char *newline =
+        reinterpret_cast<const char *>(memchr(data + m_buffer_begin, '\n', m_buffer_end - m_buffer_begin));
+    if (newline != NULL) {
+      begin = m_buffer_begin;
+      end = newline - data;
+      m_buffer_begin = end + 1;
+      return true;
+    }
+
+    if (m_eof) {
+      // The last line doesn't need a newline
+      if (m_buffer_begin == m_buffer_end) {
+        return false;
+      }
+      begin = m_buffer_begin;
+      end = m_buffer_end;
+      m_buffer_begin = m_buffer_end;
+      return true;
+    }
+
+    // Move the text of the batch to the start of the buffer, growing it if the text fills it
+    memmove(data, data + m_batch_text, m_buffer_end - m_batch_text);
+    m_buffer_begin -= m_batch_text;
+    m_buffer_end -= m_batch_text;
+    m_batch_text = 0;
+    if (m_buffer_end == m_buffer.size()) {
+      m_buffer.resize(2 * m_buffer.size());
+    }
+
+    size_t count = read_some(m_buffer.data() + m_buffer_end, m_buffer.size() - m_buffer_end);
+    if (count == 0) {
+      m_eof = true;
+    }
+    m_buffer_end += count;
+  }
+}
+
+void nd::json::ndjson_reader::parse_lines(size_t first, size_t last, const char *record_arrmeta,
+                                          dynd::json::structural_index &index) {
+  const char *text = m_buffer.data() + m_batch_text;
+  intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(m_batch.get()->metadata())->stride;
+  for (size_t i = first; i < last; ++i) {
+    const char *begin = text + m_lines[i].begin, *end = text + m_lines[i].end;
+    try {
+      index.build(begin, end);
+      json_cursor cur(index);
+      ::parse_json(m_record_tp, record_arrmeta, m_batch.data() + i * stride, cur, &m_ectx);
+      if (!cur.at_end()) {
+        throw json_parse_error(cur.pos(), "unexpected trailing JSON text", m_record_tp);
+      }
+    } catch (const parse_error &e) {
+      stringstream ss;
+      std::string line_prev, line_cur;
+      int line, column;
+      get_error_line_column(begin, end, e.get_position(), line_prev, line_cur, line, column);
+      ss << "Error parsing JSON at line " << m_lines[i].line << ", column " << column << "\n";
+      if (const json_parse_error *je = dynamic_cast<const json_parse_error *>(&e)) {
+        ss << "DyND Type: " << je->get_type() << "\n";
+      }
+      ss << "Message: " << e.what() << "\n";
+      print_json_parse_error_marker(ss, line_prev, line_cur, 1, column);
+      throw invalid_argument(ss.str());
+    }
+  }
+}
+
+intptr_t nd::json::ndjson_reader::read() {
+  char *batch_arrmeta = m_batch.get()->metadata();
+  // Free what the previous batch allocated, so the memory can be used again
+  m_batch.get_type().extended()->arrmeta_reset_buffers(batch_arrmeta);
+  const char *record_arrmeta = batch_arrmeta + sizeof(fixed_dim_type_arrmeta);
+
+  // Find the lines of the batch, all of which stay in the buffer until the next call
+  m_batch_text = m_buffer_begin;
+  m_lines.clear();
+  size_t begin, end;
+  while (static_cast<intptr_t>(m_lines.size()) < m_batch_size && next_line(begin, end)) {
+    ++m_line;
+    const char *text = m_buffer.data() + begin;
+    skip_whitespace(text, m_buffer.data() + end);
+    if (text != m_buffer.data() + end) {
+      line_span span = {begin - m_batch_text, end - m_batch_text, m_line};
+      m_lines.push_back(span);
+    }
+  }
+  size_t count = m_lines.size();
+
+  size_t nthreads = std::min(json_parse_nthreads(&m_ectx, m_buffer_begin - m_batch_text), count);
+  if (nthreads <= 1) {
+    parse_lines(0, count, record_arrmeta, m_indexes[0]);
+    return count;
+  }
+
+  // The records of each chunk allocate from memory blocks of their own, which the
+  // batch takes over once they're parsed
+  size_t nchunks = std::min(count, nthreads * json_chunks_per_thread);
+  std::vector<nd::array> chunk_arrmeta;
+  if (m_record_tp.get_arrmeta_size() > 0) {
+    for (size_t chunk = 0; chunk < nchunks; ++chunk) {
+      chunk_arrmeta.push_back(make_chunk_arrmeta(m_record_tp));
+    }
+  }
+  if (m_indexes.size() < nthreads) {
+    m_indexes.resize(nthreads);
+  }
+
+  try {
+    thread_pool::get().run(nthreads, nchunks, [&](size_t chunk, size_t thread) {
+      const char *arrmeta =
+          chunk_arrmeta.empty() ? record_arrmeta : chunk_arrmeta[chunk].get()->metadata() + sizeof(fixed_dim_type_arrmeta);
+      parse_lines(chunk * count / nchunks, (chunk + 1) * count / nchunks, arrmeta, m_indexes[thread]);
+    });
+  } catch (...) {
+    for (const nd::array &a : chunk_arrmeta) {
+      absorb_buffers(m_record_tp, record_arrmeta, a.get()->metadata() + sizeof(fixed_dim_type_arrmeta));
+    }
+    throw;
+  }
+  for (const nd::array &a : chunk_arrmeta) {
+    absorb_buffers(m_record_tp, record_arrmeta, a.get()->metadata() + sizeof(fixed_dim_type_arrmeta));
+  }
+
+  return count;
+}
+
+/**
+ * Infers the type of the JSON value at the cursor, stepping past it.
+ */
+static ndt::type discover_type(json_cursor &cur);
+
+/**
+ * Returns the type that values of both of the discovered types ``tp0`` and ``tp1``
+ * can be parsed as, or a null type if there's none. Numbers become float64 if either
+ * is, null makes an option, arrays of different sizes become a var dim, and a field
+ * that only one of two objects has becomes an option.
+ */
+static ndt::type unify_discovered_types(const ndt::type &tp0, const ndt::type &tp1) {
+  if (tp0 == tp1) {
+    return tp0;
+  }
+
+  type_id_t id0 = tp0.get_id(), id1 = tp1.get_id();
+  if (id0 == option_id || id1 == option_id) {
+    const ndt::type &value_tp0 = (id0 == option_id) ? tp0.extended<ndt::option_type>()->get_value_type() : tp0;
+    const ndt::type &value_tp1 = (id1 == option_id) ? tp1.extended<ndt::option_type>()->get_value_type() : tp1;
+    ndt::type value_tp;
+    if (value_tp0.get_id() == any_kind_id) {
+      value_tp = value_tp1;
+    } else if (value_tp1.get_id() == any_kind_id) {
+      value_tp = value_tp0;
+    } else {
+      value_tp = unify_discovered_types(value_tp0, value_tp1);
+      if (value_tp.is_null()) {
+        return value_tp;
+      }
+    }
+    return value_tp.get_id() == option_id ? value_tp : ndt::make_type<ndt::option_type>(value_tp);
+  }
+
+  if ((id0 == int64_id || id0 == float64_id) && (id1 == int64_id || id1 == float64_id)) {
+    return ndt::make_type<double>();
+  }
+
+  // An empty array is discovered as an empty tuple, which joins any dim as a var dim
+  if (id0 == tuple_id && tp0.extended<ndt::tuple_type>()->get_field_count() == 0 &&
+      (id1 == fixed_dim_id || id1 == var_dim_id)) {
+    return ndt::make_var_dim(tp1.extended<ndt::base_dim_type>()->get_element_type());
+  }
+  if (id1 == tuple_id && tp1.extended<ndt::tuple_type>()->get_field_count() == 0 &&
+      (id0 == fixed_dim_id || id0 == var_dim_id)) {
+    return ndt::make_var_dim(tp0.extended<ndt::base_dim_type>()->get_element_type());
+  }
+
+  if ((id0 == fixed_dim_id || id0 == var_dim_id) && (id1 == fixed_dim_id || id1 == var_dim_id)) {
+    ndt::type element_tp = unify_discovered_types(tp0.extended<ndt::base_dim_type>()->get_element_type(),
+                                                  tp1.extended<ndt::base_dim_type>()->get_element_type());
+    if (element_tp.is_null()) {
+      return element_tp;
+    }
+    if (id0 == fixed_dim_id && id1 == fixed_dim_id &&
+        tp0.extended<ndt::fixed_dim_type>()->get_fixed_dim_size() ==
+            tp1.extended<ndt::fixed_dim_type>()->get_fixed_dim_size()) {
+      return ndt::make_fixed_dim(tp0.extended<ndt::fixed_dim_type>()->get_fixed_dim_size(), element_tp);
+    }
+    return ndt::make_var_dim(element_tp);
+  }
+
+  if (id0 == struct_id && id1 == struct_id) {
+    const ndt::struct_type *st0 = tp0.extended<ndt::struct_type>();
+    const ndt::struct_type *st1 = tp1.extended<ndt::struct_type>();
+    std::vector<std::string> names(st0->get_field_names());
     std::vector<ndt::type> types;
-    for (;;) {
-      const char *strbegin, *strend;
-      bool escaped;
-      skip_whitespace(begin, end);
-      if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
-        throw parse_error(begin, "expected string for name in object dict");
+    for (intptr_t i = 0; i < st0->get_field_count(); ++i) {
+      intptr_t j = st1->get_field_index(names[i]);
+      types.push_back((j == -1) ? unify_discovered_types(st0->get_field_type(i), ndt::type("?Any"))
+                                : unify_discovered_types(st0->get_field_type(i), st1->get_field_type(j)));
+      if (types.back().is_null()) {
+        return types.back();
       }
-      names.emplace_back(strbegin, strend - strbegin);
-      if (!parse_token(begin, end, ":")) {
-        throw parse_error(begin, "expected ':' separating name from value in object dict");
+    }
+    for (intptr_t j = 0; j < st1->get_field_count(); ++j) {
+      if (st0->get_field_index(st1->get_field_name(j)) == -1) {
+        names.push_back(st1->get_field_name(j));
+        types.push_back(unify_discovered_types(st1->get_field_type(j), ndt::type("?Any")));
       }
-      types.push_back(discover_type(begin, end));
-      if (!parse_token(begin, end, ",")) {
-        break;
+    }
+    return ndt::make_type<ndt::struct_type>(names, types);
+  }
+
+  if (id0 == tuple_id && id1 == tuple_id) {
+    const ndt::tuple_type *tt0 = tp0.extended<ndt::tuple_type>();
+    const ndt::tuple_type *tt1 = tp1.extended<ndt::tuple_type>();
+    if (tt0->get_field_count() != tt1->get_field_count()) {
+      return ndt::type();
+    }
+    std::vector<ndt::type> types;
+    for (intptr_t i = 0; i < tt0->get_field_count(); ++i) {
+      types.push_back(unify_discovered_types(tt0->get_field_type(i), tt1->get_field_type(i)));
+      if (types.back().is_null()) {
+        return types.back();
       }
     }
-    if (!parse_token(begin, end, "}")) {
-      throw parse_error(begin, "expected object separator ',' or terminator '}'");
+    return ndt::make_type<ndt::tuple_type>(types);
+  }
+
+  return ndt::type();
+}
+
+static ndt::type discover_type(json_cursor &cur) {
+  if (cur.at_end()) {
+    throw parse_error(cur.pos(), "malformed JSON, expecting an element");
+  }
+  const char *strbegin, *strend;
+  bool escaped;
+  switch (*cur.pos()) {
+  // Object
+  case '{': {
+    ++cur.it;
+    std::vector<std::string> names;
+    std::vector<ndt::type> types;
+    if (!cur.parse_token('}')) {
+      for (;;) {
+        if (!parse_json_string(cur, strbegin, strend, escaped)) {
+          throw parse_error(cur.pos(), "expected string for name in object dict");
+        }
+        if (escaped) {
+          names.emplace_back();
+          unescape_string(strbegin, strend, names.back());
+        } else {
+          names.emplace_back(strbegin, strend);
+        }
+        if (!cur.parse_token(':')) {
+          throw parse_error(cur.pos(), "expected ':' separating name from value in object dict");
+        }
+        types.push_back(discover_type(cur));
+        if (!cur.parse_token(',')) {
+          break;
+        }
+      }
+      if (!cur.parse_token('}')) {
+        throw parse_error(cur.pos(), "expected object separator ',' or terminator '}'");
+      }
     }
-    return ndt::struct_type::make(names, types);
+    return ndt::make_type<ndt::struct_type>(names, types);
   }
   // Array
   case '[': {
-    ++begin;
-    if (parse_token(begin, end, "]")) {
-      return ndt::tuple_type::make();
+    ++cur.it;
+    if (cur.parse_token(']')) {
+      return ndt::make_type<ndt::tuple_type>();
     }
     std::vector<ndt::type> types;
-    ndt::type common_tp = discover_type(begin, end);
+    ndt::type common_tp = discover_type(cur);
     types.push_back(common_tp);
-    for (;;) {
-      if (!parse_token(begin, end, ",")) {
-        break;
-      }
-      const ndt::type &tp = discover_type(begin, end);
+    while (cur.parse_token(',')) {
+      types.push_back(discover_type(cur));
       if (!common_tp.is_null()) {
-        common_tp = ndt::common_type(common_tp, tp);
+        common_tp = unify_discovered_types(common_tp, types.back());
       }
-      types.push_back(tp);
     }
-    if (!parse_token(begin, end, "]")) {
-      throw parse_error(begin, "expected array separator ',' or terminator ']'");
+    if (!cur.parse_token(']')) {
+      throw parse_error(cur.pos(), "expected array separator ',' or terminator ']'");
     }
     if (common_tp.is_null()) {
-      return ndt::tuple_type::make(types);
+      return ndt::make_type<ndt::tuple_type>(types);
     }
     return ndt::make_fixed_dim(types.size(), common_tp);
   }
-  case '"': {
-    const char *strbegin, *strend;
-    bool escaped;
-    if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
-      throw parse_error(begin, "invalid string");
-    }
-    return ndt::type(string_id);
-  }
-  case 'T':
-  case 't':
-    ++begin;
-    if (parse_token(begin, end, "rue")) {
-      return ndt::make_type<bool1>();
-    }
-    throw parse_error(begin, "invalid json value");
-  case 'F':
-  case 'f':
-    ++begin;
-    if (parse_token(begin, end, "alse")) {
-      return ndt::make_type<bool1>();
-    }
-    throw parse_error(begin, "invalid json value");
-  case 'n':
-    if (parse_token(begin, end, "null")) {
-      return ndt::make_type<ndt::option_type>(ndt::type("Any"));
+  case '"':
+    if (!parse_json_string(cur, strbegin, strend, escaped)) {
+      throw parse_error(cur.pos(), "invalid string");
     }
-    throw parse_error(begin, "invalid json value");
-  default:
-    if (c == '-' || ('0' <= c && c <= '9')) {
-      const char *nbegin = NULL, *nend = NULL;
-      if (!json::parse_number(begin, end, nbegin, nend)) {
-        throw parse_error(begin, "invalid number");
-      }
-      int64_t int_val;
-      try {
-        parse_int64(int_val, nbegin, nend);
-        return ndt::make_type<int64>();
-      }
-      catch (...) {
-      }
-      double float_val;
-      if (!parse_double(float_val, nbegin, nend)) {
-        return ndt::make_type<double>();
+    return ndt::make_type<ndt::string_type>();
+  default: {
+    const char *begin = cur.pos(), *end = cur.value_end();
+    ndt::type tp;
+    if (parse_token(begin, end, "true") || parse_token(begin, end, "false")) {
+      tp = ndt::make_type<bool1>();
+    } else if (parse_token(begin, end, "null")) {
+      tp = ndt::type("?Any");
+    } else if (json::parse_number(begin, end, strbegin, strend)) {
+      tp = ndt::make_type<int64>();
+      if (std::find_if(strbegin, strend, [](char c) { return c == '.' || c == 'e' || c == 'E'; }) != strend) {
+        tp = ndt::make_type<double>();
+      } else {
+        try {
+          parse<int64_t>(strbegin, strend);
+        } catch (const std::overflow_error &) {
+          tp = ndt::make_type<double>();
+        }
       }
+    } else {
       throw parse_error(begin, "invalid json value");
     }
-    else {
+    skip_whitespace(begin, end);
+    if (begin != end) {
       throw parse_error(begin, "invalid json value");
     }
+    ++cur.it;
+    return tp;
+  }
+  }
+}
+
+namespace {
+
+// The seed of the generator that picks a random sample, fixed so that discovering the
+// type of the same document always gives the same result
+const unsigned json_discover_seed = 5489u;
+
+} // anonymous namespace
+
+/**
+ * Picks which elements of an array of ``size`` elements discovery looks at, in order.
+ */
+static void sample_json_array(size_t size, ndt::json::discover_sample_t sample, size_t sample_size,
+                              std::vector<size_t> &out_elements) {
+  if (sample == ndt::json::discover_sample_all || sample_size >= size) {
+    sample_size = size;
+  }
+  out_elements.resize(sample_size);
+  for (size_t i = 0; i < sample_size; ++i) {
+    out_elements[i] = i;
   }
 
-  throw runtime_error("json parsing error");
+  if (sample == ndt::json::discover_sample_random && sample_size < size) {
+    // Reservoir sampling, where element i replaces a random one of the sample with
+    // probability sample_size / (i + 1)
+    std::mt19937 gen(json_discover_seed);
+    for (size_t i = sample_size; i < size; ++i) {
+      size_t j = std::uniform_int_distribution<size_t>(0, i)(gen);
+      if (j < sample_size) {
+        out_elements[j] = i;
+      }
+    }
+    std::sort(out_elements.begin(), out_elements.end());
+  }
 }
-*/
 
-/*
-void ndt::json::discover(ndt::type &res, const char *json_begin, const char *json_end)
-{
-  try {
-    const char *begin = json_begin, *end = json_end;
-    res = ::discover_type(begin, end);
-    skip_whitespace(begin, end);
-    if (begin != end) {
-      throw parse_error(begin, "unexpected trailing JSON text");
+/**
+ * Discovers the types of some of the elements of a document that's a single array
+ * and unifies them, splitting the elements into chunks that are discovered on the
+ * thread pool when there are enough of them. Returns a null type if the elements
+ * don't unify.
+ */
+static ndt::type discover_json_elements(const json::structural_index &index, const std::vector<size_t> &starts,
+                                        const std::vector<size_t> &elements, const eval::eval_context *ectx) {
+  size_t nelements = elements.size();
+  size_t nthreads = json_parse_nthreads(ectx, (index.get_end() - index.get_begin()) / starts.size() * nelements);
+  size_t nchunks = (nthreads <= 1) ? 1 : std::min(nelements, nthreads * json_chunks_per_thread);
+
+  std::vector<ndt::type> chunk_types(nchunks);
+  auto discover_chunk = [&](size_t chunk, size_t DYND_UNUSED(thread)) {
+    size_t first = chunk * nelements / nchunks, last = (chunk + 1) * nelements / nchunks;
+    ndt::type common_tp;
+    for (size_t i = first; i < last; ++i) {
+      size_t element = elements[i];
+      json_cursor cur(index, starts[element]);
+      ndt::type tp = discover_type(cur);
+      // Each element is followed by the ',' before the next one, or by the final ']'
+      size_t next = (element + 1 < starts.size()) ? starts[element + 1] - 1 : index.size() - 1;
+      if (static_cast<size_t>(cur.it - index.positions()) != next) {
+        throw parse_error(cur.pos(), "expected array separator ',' or terminator ']'");
+      }
+      common_tp = (i == first) ? tp : unify_discovered_types(common_tp, tp);
+      if (common_tp.is_null()) {
+        break;
+      }
     }
+    chunk_types[chunk] = common_tp;
+  };
+  if (nchunks == 1) {
+    discover_chunk(0, 0);
+  } else {
+    thread_pool::get().run(nthreads, nchunks, discover_chunk);
+  }
+
+  ndt::type common_tp = chunk_types[0];
+  for (size_t chunk = 1; chunk < nchunks && !common_tp.is_null(); ++chunk) {
+    common_tp = chunk_types[chunk].is_null() ? chunk_types[chunk] : unify_discovered_types(common_tp, chunk_types[chunk]);
+  }
+
+  return common_tp;
+}
+
+void ndt::json::discover(ndt::type &res, const char *json_begin, const char *json_end, discover_sample_t sample,
+                         intptr_t sample_size, const eval::eval_context *ectx) {
+  if (sample != discover_sample_all && sample_size <= 0) {
+    stringstream ss;
+    ss << "JSON discovery needs a positive sample size, not " << sample_size;
+    throw invalid_argument(ss.str());
   }
-  catch (const parse_error &e) {
+
+  try {
+    dynd::json::structural_index index(json_begin, json_end);
+
+    // A document that's a single array is discovered an element at a time, which a
+    // sample or the thread pool can speed up
+    std::vector<size_t> starts, elements;
+    if (split_json_array(index, starts) && !starts.empty()) {
+      sample_json_array(starts.size(), sample, sample_size, elements);
+      ndt::type element_tp = discover_json_elements(index, starts, elements, ectx);
+      if (!element_tp.is_null()) {
+        res = ndt::make_fixed_dim(starts.size(), element_tp);
+        return;
+      }
+    }
+
+    // Otherwise, or when the elements only fit a tuple, the whole document is discovered
+    json_cursor cur(index);
+    res = discover_type(cur);
+    if (!cur.at_end()) {
+      throw parse_error(cur.pos(), "unexpected trailing JSON text");
+    }
+  } catch (const parse_error &e) {
     stringstream ss;
     std::string line_prev, line_cur;
     int line, column;
@@ -870,4 +1508,3 @@ void ndt::json::discover(ndt::type &res, const char *json_begin, const char *jso
     throw invalid_argument(ss.str());
   }
 }
-*/
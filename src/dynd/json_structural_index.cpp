@@ -0,0 +1,208 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <dynd/json_structural_index.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// One bit per byte of a 64-byte block, for each class of character the index cares about
+struct block_masks {
+  uint64_t backslash;
+  uint64_t quote;
+  // The brackets, braces, colons and commas
+  uint64_t op;
+  // The JSON whitespace characters, space, tab, newline and carriage return
+  uint64_t whitespace;
+};
+
+#if defined(__AVX2__)
+
+inline uint64_t eq_mask(__m256i lo, __m256i hi, char c) {
+  __m256i v = _mm256_set1_epi8(c);
+  uint32_t lo_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v)));
+  uint32_t hi_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v)));
+  return lo_bits | (static_cast<uint64_t>(hi_bits) << 32);
+}
+
+void classify(const char *data, block_masks &m) {
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + 32));
+  // Setting bit 5 maps '[' to '{' and ']' to '}'
+  __m256i bit5 = _mm256_set1_epi8(0x20);
+  __m256i lo_folded = _mm256_or_si256(lo, bit5), hi_folded = _mm256_or_si256(hi, bit5);
+
+  m.backslash = eq_mask(lo, hi, '\\');
+  m.quote = eq_mask(lo, hi, '"');
+  m.op = eq_mask(lo_folded, hi_folded, '{') | eq_mask(lo_folded, hi_folded, '}') | eq_mask(lo, hi, ':') |
+         eq_mask(lo, hi, ',');
+  m.whitespace = eq_mask(lo, hi, ' ') | eq_mask(lo, hi, '\t') | eq_mask(lo, hi, '\n') | eq_mask(lo, hi, '\r');
+}
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+inline uint64_t eq_mask(const __m128i (&v)[4], char c) {
+  __m128i cv = _mm_set1_epi8(c);
+  uint64_t bits = 0;
+  for (int i = 0; i < 4; ++i) {
+    bits |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v[i], cv)))) << (16 * i);
+  }
+  return bits;
+}
+
+void classify(const char *data, block_masks &m) {
+  __m128i v[4], folded[4];
+  // Setting bit 5 maps '[' to '{' and ']' to '}'
+  __m128i bit5 = _mm_set1_epi8(0x20);
+  for (int i = 0; i < 4; ++i) {
+    v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i));
+    folded[i] = _mm_or_si128(v[i], bit5);
+  }
+
+  m.backslash = eq_mask(v, '\\');
+  m.quote = eq_mask(v, '"');
+  m.op = eq_mask(folded, '{') | eq_mask(folded, '}') | eq_mask(v, ':') | eq_mask(v, ',');
+  m.whitespace = eq_mask(v, ' ') | eq_mask(v, '\t') | eq_mask(v, '\n') | eq_mask(v, '\r');
+}
+
+#else
+
+void classify(const char *data, block_masks &m) {
+  m.backslash = m.quote = m.op = m.whitespace = 0;
+  for (int i = 0; i < 64; ++i) {
+    uint64_t bit = static_cast<uint64_t>(1) << i;
+    switch (data[i]) {
+    case '\\':
+      m.backslash |= bit;
+      break;
+    case '"':
+      m.quote |= bit;
+      break;
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      m.op |= bit;
+      break;
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+      m.whitespace |= bit;
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+#endif
+
+inline int count_trailing_zeros(uint64_t x) {
+#if defined(_MSC_VER)
+  unsigned long i;
+  _BitScanForward64(&i, x);
+  return static_cast<int>(i);
+#else
+  return __builtin_ctzll(x);
+#endif
+}
+
+// Sets each bit to the parity of the bits at or below it, which turns the quotes
+// of a block into a mask of the bytes inside strings
+inline uint64_t prefix_xor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+} // anonymous namespace
+
+void json::structural_index::build(const char *begin, const char *end) {
+  m_begin = begin;
+  m_end = end;
+
+  size_t size = end - begin;
+  m_positions.resize(std::max<size_t>(size / 8, 64));
+  size_t count = 0;
+
+  // The state carried from one block to the next
+  uint64_t prev_escaped = 0, prev_in_string = 0, prev_scalar = 0;
+
+  for (size_t offset = 0; offset < size; offset += 64) {
+    block_masks m;
+    if (size - offset >= 64) {
+      classify(begin + offset, m);
+    } else {
+      // Pad the last block with whitespace
+      char block[64];
+      memset(block, ' ', sizeof(block));
+      memcpy(block, begin + offset, size - offset);
+      classify(block, m);
+    }
+
+    // A backslash escapes the next character, unless it's escaped itself. Backslashes
+    // are rare, so they're walked one at a time.
+    uint64_t escaped = prev_escaped;
+    prev_escaped = 0;
+    for (uint64_t backslash = m.backslash & ~escaped; backslash != 0; backslash &= backslash - 1) {
+      uint64_t bit = backslash & (~backslash + 1);
+      if ((bit & escaped) == 0) {
+        if (bit >> 63) {
+          prev_escaped = 1;
+        } else {
+          escaped |= bit << 1;
+        }
+      }
+    }
+
+    // The bytes inside strings, including the opening quote but not the closing one
+    uint64_t quote = m.quote & ~escaped;
+    uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+    prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+    // The first byte of each run of characters outside strings that aren't whitespace,
+    // quotes or operators
+    uint64_t scalar = ~(m.op | m.whitespace | quote | in_string);
+    uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+    prev_scalar = scalar >> 63;
+
+    uint64_t structurals = (m.op & ~in_string) | (quote & in_string) | scalar_start;
+
+    if (m_positions.size() < count + 64) {
+      m_positions.resize(2 * m_positions.size());
+    }
+    size_t *positions = m_positions.data() + count;
+    for (; structurals != 0; structurals &= structurals - 1) {
+      *positions++ = offset + count_trailing_zeros(structurals);
+    }
+    count = positions - m_positions.data();
+  }
+
+  m_positions.resize(count + 1);
+  m_positions[count] = size;
+}
@@ -11,9 +11,9 @@
 using namespace std;
 using namespace dynd;
 
-static std::vector<ndt::type> func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc),
-                                       const ndt::type *DYND_UNUSED(src_tp)) {
-  return {dst_tp};
+static void func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                     ndt::type *res) {
+  res[0] = dst_tp;
 }
 
 DYND_API nd::callable nd::limits::max = nd::make_callable<nd::multidispatch_callable<1>>(
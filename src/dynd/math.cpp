@@ -32,19 +32,19 @@ DYND_API nd::callable nd::real = nd::functional::elwise(nd::make_callable<nd::mu
     ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                        {ndt::make_type<ndt::scalar_kind_type>()}),
     nd::callable::make_all<nd::real_callable, type_sequence<dynd::complex<float>, dynd::complex<double>>>(
-        [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; })));
+        [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+           ndt::type *res) { res[0] = src_tp[0]; })));
 
 DYND_API nd::callable nd::imag = nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<1>>(
     ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                        {ndt::make_type<ndt::scalar_kind_type>()}),
     nd::callable::make_all<nd::imag_callable, type_sequence<dynd::complex<float>, dynd::complex<double>>>(
-        [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; })));
+        [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+           ndt::type *res) { res[0] = src_tp[0]; })));
 
 DYND_API nd::callable nd::conj = nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<1>>(
     ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                        {ndt::make_type<ndt::scalar_kind_type>()}),
     nd::callable::make_all<nd::conj_callable, type_sequence<dynd::complex<float>, dynd::complex<double>>>(
-        [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; })));
+        [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+           ndt::type *res) { res[0] = src_tp[0]; })));
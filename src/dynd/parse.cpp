@@ -20,9 +20,9 @@ using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc),
-                                       const ndt::type *DYND_UNUSED(src_tp)) {
-  return {dst_tp};
+static void func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                     ndt::type *res) {
+  res[0] = dst_tp;
 }
 
 nd::callable make_dynamic_parse() {
@@ -3,6 +3,7 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
 #include <stdexcept>
 #include <string>
 #include <string>
@@ -69,10 +70,18 @@ bool dynd::parse_doublequote_string_no_ws(const char *&rbegin, const char *end,
   if (!parse_token_no_ws(begin, end, '\"')) {
     return false;
   }
+  // The next quote, which ends the string unless it's escaped
+  const char *quote = NULL;
   for (;;) {
-    if (begin == end) {
-      throw parse_error(rbegin, "string has no ending quote");
+    if (quote == NULL || quote < begin) {
+      quote = static_cast<const char *>(memchr(begin, '"', end - begin));
+      if (quote == NULL) {
+        throw parse_error(rbegin, "string has no ending quote");
+      }
     }
+    // Jump to the first backslash before the quote, or to the quote itself
+    const char *backslash = static_cast<const char *>(memchr(begin, '\\', quote - begin));
+    begin = (backslash != NULL) ? backslash : quote;
     char c = *begin++;
     if (c == '\\') {
       escaped = true;
@@ -33,6 +33,7 @@ registry_entry &dynd::registered() {
                                                 {"conj", nd::conj},
                                                 {"cos", nd::cos},
                                                 {"dereference", nd::dereference},
+                                                {"describe", nd::describe},
                                                 {"divide", nd::divide},
                                                 {"equal", nd::equal},
                                                 {"exp", nd::exp},
@@ -3,6 +3,7 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <dynd/callables/describe_callable.hpp>
 #include <dynd/callables/limits/max_callable.hpp>
 #include <dynd/callables/limits/min_callable.hpp>
 #include <dynd/callables/max_callable.hpp>
@@ -19,18 +20,28 @@ using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-                                       const ndt::type *src_tp) {
-  return {src_tp[0]};
+static void func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                     ndt::type *res) {
+  res[0] = src_tp[0];
 }
 
-static std::vector<ndt::type> func_ptr_dst(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc),
-                                           const ndt::type *DYND_UNUSED(src_tp)) {
-  return {dst_tp};
+static void func_ptr_dst(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                         ndt::type *res) {
+  res[0] = dst_tp;
 }
 
 } // unnnamed namespace
 
+DYND_API nd::callable nd::describe = nd::functional::reduction(
+    nd::make_callable<nd::describe_identity_callable>(),
+    nd::make_callable<nd::multidispatch_callable<1>>(
+        ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::any_kind_type>(),
+                                           {ndt::make_type<ndt::scalar_kind_type>()}),
+        nd::callable::make_all<nd::describe_callable, type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t,
+                                                                     uint16_t, uint32_t, uint64_t, float, double>>(
+            func_ptr)),
+    nd::make_callable<nd::describe_combine_callable>());
+
 DYND_API nd::callable nd::max = nd::functional::reduction(
     nd::make_callable<nd::multidispatch_callable<1>>(
         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::any_kind_type>(), {}),
@@ -8,25 +8,35 @@
 #include <dynd/callables/multidispatch_callable.hpp>
 #include <dynd/callables/sum_callable.hpp>
 #include <dynd/functional.hpp>
+#include <dynd/types/option_type.hpp>
 #include <dynd/types/scalar_kind_type.hpp>
 
 using namespace dynd;
 
 namespace {
 
-static std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-                                       const ndt::type *src_tp) {
-  return {src_tp[0].get_dtype()};
+typedef type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float16, float, double,
+                      dynd::complex<float>, dynd::complex<double>>
+    sum_types;
+
+static void func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                     ndt::type *res) {
+  res[0] = src_tp[0].get_dtype();
+}
+
+static void func_ptr_dst(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                         ndt::type *res) {
+  res[0] = dst_tp;
 }
 
 } // unnamed namespace
 
 DYND_API nd::callable nd::sum = nd::functional::reduction(
-    [] { return 0; },
     nd::make_callable<nd::multidispatch_callable<1>>(
-        ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
-                                           {ndt::make_type<ndt::scalar_kind_type>()}),
-        nd::callable::make_all<nd::sum_callable,
-                               type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t,
-                                             float16, float, double, dynd::complex<float>, dynd::complex<double>>>(
-            func_ptr)));
+        ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::any_kind_type>(), {}),
+        nd::callable::make_all<nd::sum_identity_callable, sum_types>(func_ptr_dst)),
+    nd::make_callable<nd::multidispatch_callable<1>>(
+        ndt::make_type<ndt::callable_type>(
+            ndt::make_type<ndt::scalar_kind_type>(), {ndt::make_type<ndt::scalar_kind_type>()},
+            {{ndt::make_type<ndt::option_type>(ndt::make_type<summation_mode>()), "summation"}}),
+        nd::callable::make_all<nd::sum_callable, sum_types>(func_ptr)));
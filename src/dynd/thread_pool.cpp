@@ -0,0 +1,202 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include <dynd/thread_pool.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+thread_local bool running_task = false;
+
+struct task_scope {
+  bool prev;
+
+  task_scope() : prev(running_task) { running_task = true; }
+
+  ~task_scope() { running_task = prev; }
+};
+
+} // anonymous namespace
+
+struct thread_pool::job {
+  struct range {
+    std::mutex mutex;
+    size_t begin;
+    size_t end;
+  };
+
+  const std::function<void(size_t, size_t)> &f;
+  size_t nthreads;
+  std::unique_ptr<range[]> ranges;
+  std::atomic<bool> failed;
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+
+  size_t pending;
+  std::mutex pending_mutex;
+  std::condition_variable pending_cv;
+
+  job(size_t nthreads, size_t ntasks, const std::function<void(size_t, size_t)> &f)
+      : f(f), nthreads(nthreads), ranges(new range[nthreads]), failed(false), pending(nthreads - 1) {
+    for (size_t i = 0; i < nthreads; ++i) {
+      ranges[i].begin = ntasks * i / nthreads;
+      ranges[i].end = ntasks * (i + 1) / nthreads;
+    }
+  }
+
+  bool pop(size_t thread, size_t &task) {
+    range &r = ranges[thread];
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (r.begin == r.end) {
+      return false;
+    }
+
+    task = r.begin++;
+    return true;
+  }
+
+  bool steal(size_t thread, size_t &task) {
+    for (size_t k = 1; k < nthreads; ++k) {
+      range &r = ranges[(thread + k) % nthreads];
+      std::lock_guard<std::mutex> lock(r.mutex);
+      if (r.begin != r.end) {
+        task = --r.end;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void participate(size_t thread) {
+    task_scope scope;
+
+    size_t task;
+    while (!failed.load(std::memory_order_relaxed) && (pop(thread, task) || steal(thread, task))) {
+      try {
+        f(task, thread);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+        failed = true;
+      }
+    }
+  }
+};
+
+thread_pool::thread_pool(size_t nworkers) : m_nworkers(0), m_job(nullptr), m_generation(0), m_stop(false) {
+  reserve(nworkers + 1);
+}
+
+thread_pool::~thread_pool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+
+  for (std::thread &thread : m_threads) {
+    thread.join();
+  }
+}
+
+void thread_pool::work(size_t thread) {
+  size_t generation = 0;
+  while (true) {
+    job *j;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+
+      generation = m_generation;
+      // Workers beyond the size of the run must not touch it, as it may finish without them
+      j = (m_job != nullptr && thread < m_job->nthreads) ? m_job : nullptr;
+    }
+
+    if (j == nullptr) {
+      continue;
+    }
+
+    j->participate(thread);
+
+    std::lock_guard<std::mutex> lock(j->pending_mutex);
+    if (--j->pending == 0) {
+      j->pending_cv.notify_one();
+    }
+  }
+}
+
+void thread_pool::run(size_t nthreads, size_t ntasks, const std::function<void(size_t, size_t)> &f) {
+  if (nthreads > ntasks) {
+    nthreads = ntasks;
+  }
+  if (nthreads > get_nthreads()) {
+    nthreads = get_nthreads();
+  }
+
+  if (nthreads <= 1 || in_task()) {
+    task_scope scope;
+    for (size_t task = 0; task < ntasks; ++task) {
+      f(task, 0);
+    }
+    return;
+  }
+
+  // Only one run at a time can use the workers
+  std::lock_guard<std::mutex> run_lock(m_run_mutex);
+
+  job j(nthreads, ntasks, f);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_job = &j;
+    ++m_generation;
+  }
+  m_cv.notify_all();
+
+  j.participate(0);
+
+  {
+    std::unique_lock<std::mutex> lock(j.pending_mutex);
+    j.pending_cv.wait(lock, [&] { return j.pending == 0; });
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_job = nullptr;
+  }
+
+  if (j.exception) {
+    std::rethrow_exception(j.exception);
+  }
+}
+
+void thread_pool::reserve(size_t nthreads) {
+  // The workers can't change while a run is using them
+  std::lock_guard<std::mutex> run_lock(m_run_mutex);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  while (m_threads.size() + 1 < nthreads) {
+    m_threads.emplace_back(&thread_pool::work, this, m_threads.size() + 1);
+    ++m_nworkers;
+  }
+}
+
+bool thread_pool::in_task() { return running_task; }
+
+thread_pool &thread_pool::get() {
+  static thread_pool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+  return pool;
+}
@@ -59,9 +59,9 @@ char *dynd::iterdata_broadcasting_terminator_reset(iterdata_common *iterdata, ch
   return data;
 }
 
-ndt::type::type(const std::string &rep) { type_from_datashape(rep).swap(*this); }
+ndt::type::type(const std::string &rep) { intern_datashape(rep.data(), rep.data() + rep.size()).swap(*this); }
 
-ndt::type::type(const char *rep_begin, const char *rep_end) { type_from_datashape(rep_begin, rep_end).swap(*this); }
+ndt::type::type(const char *rep_begin, const char *rep_end) { intern_datashape(rep_begin, rep_end).swap(*this); }
 
 size_t ndt::type::get_data_alignment() const {
   switch (reinterpret_cast<uintptr_t>(m_ptr)) {
@@ -211,7 +211,8 @@ ndt::type ndt::type::at_array(int nindices, const irange *indices) const {
 }
 
 bool ndt::type::match(const type &other, std::map<std::string, type> &tp_vars) const {
-  return m_ptr == other.m_ptr || (!is_builtin() && m_ptr->match(other, tp_vars));
+  // A symbolic type may contain type variables, which have to be bound even when matching itself
+  return (m_ptr == other.m_ptr && !is_symbolic()) || (!is_builtin() && m_ptr->match(other, tp_vars));
 }
 
 ndt::type ndt::type::apply_linear_index(intptr_t nindices, const irange *indices, size_t current_i,
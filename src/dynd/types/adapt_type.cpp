@@ -39,3 +39,9 @@ bool ndt::adapt_type::operator==(const base_type &rhs) const {
 
   return false;
 }
+
+size_t ndt::adapt_type::get_hash() const {
+  size_t hash = hash_combine(hash_combine(static_cast<size_t>(adapt_id), m_value_tp.hash()), m_storage_tp.hash());
+  hash = hash_combine(hash, reinterpret_cast<size_t>(m_forward.get()));
+  return hash_combine(hash, reinterpret_cast<size_t>(m_inverse.get()));
+}
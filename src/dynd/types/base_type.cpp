@@ -3,15 +3,152 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include <dynd/type.hpp>
 
 #include <dynd/buffer.hpp>
+#include <dynd/types/datashape_parser.hpp>
 
 using namespace std;
 using namespace dynd;
 
-// Default destructor for the extended type does nothing
-ndt::base_type::~base_type() {}
+namespace {
+
+/**
+ * The interned types by hash, and the datashape strings they were parsed from. Neither
+ * holds a reference to a type, instead a type removes itself when it is destroyed.
+ */
+struct intern_table {
+  std::mutex mutex;
+  std::unordered_multimap<size_t, const ndt::base_type *> types;
+  std::unordered_map<std::string, const ndt::base_type *> datashapes;
+  std::unordered_multimap<const ndt::base_type *, std::string> datashapes_of;
+};
+
+intern_table &get_intern_table() {
+  // Never destroyed, as types in static variables may be released after it would be
+  static intern_table *table = new intern_table;
+  return *table;
+}
+
+} // anonymous namespace
+
+ndt::base_type::~base_type() {
+  if (!m_interned.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  intern_table &table = get_intern_table();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  auto types = table.types.equal_range(m_hash);
+  for (auto it = types.first; it != types.second; ++it) {
+    if (it->second == this) {
+      table.types.erase(it);
+      break;
+    }
+  }
+
+  auto datashapes = table.datashapes_of.equal_range(this);
+  for (auto it = datashapes.first; it != datashapes.second; ++it) {
+    auto ds = table.datashapes.find(it->second);
+    if (ds != table.datashapes.end() && ds->second == this) {
+      table.datashapes.erase(ds);
+    }
+  }
+  table.datashapes_of.erase(datashapes.first, datashapes.second);
+}
+
+ndt::type ndt::intern(const type &tp) {
+  if (tp.is_builtin() || tp.extended()->is_interned()) {
+    return tp;
+  }
+
+  size_t hash = tp.extended()->get_hash();
+  intern_table &table = get_intern_table();
+
+  // Comparing types may run callables, which can make and release types and so take the
+  // table's lock. The candidates are therefore referenced under the lock but compared
+  // without it, and the lock is retaken to insert. Any type with the same hash that was
+  // interned in the meantime is compared on another pass. The references are released
+  // once the lock is, as releasing the last one takes the lock to remove the type.
+  std::vector<type> compared;
+  for (;;) {
+    std::vector<type> candidates;
+    {
+      std::lock_guard<std::mutex> lock(table.mutex);
+      auto range = table.types.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it) {
+        const base_type *candidate = it->second;
+        if (std::any_of(compared.begin(), compared.end(),
+                        [candidate](const type &other) { return other.extended() == candidate; })) {
+          continue;
+        }
+
+        // Take a reference, unless the candidate is already being destroyed
+        long count = candidate->m_use_count.load();
+        while (count != 0 && !candidate->m_use_count.compare_exchange_weak(count, count + 1)) {
+        }
+        if (count != 0) {
+          candidates.emplace_back(candidate, false);
+        }
+      }
+
+      if (candidates.empty()) {
+        base_type *self = const_cast<base_type *>(tp.extended());
+        self->m_hash = hash;
+        self->m_interned.store(true, std::memory_order_release);
+        table.types.emplace(hash, self);
+
+        return tp;
+      }
+    }
+
+    for (type &candidate : candidates) {
+      if (*candidate.extended() == *tp.extended()) {
+        return candidate;
+      }
+      compared.push_back(std::move(candidate));
+    }
+  }
+}
+
+ndt::type ndt::intern_datashape(const char *begin, const char *end) {
+  std::string datashape(begin, end);
+  intern_table &table = get_intern_table();
+
+  {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.datashapes.find(datashape);
+    if (it != table.datashapes.end()) {
+      const base_type *tp = it->second;
+      if (is_builtin_type(tp)) {
+        return type(tp, false);
+      }
+
+      long count = tp->m_use_count.load();
+      while (count != 0 && !tp->m_use_count.compare_exchange_weak(count, count + 1)) {
+      }
+      if (count != 0) {
+        return type(tp, false);
+      }
+    }
+  }
+
+  type tp = intern(type_from_datashape(begin, end));
+
+  std::lock_guard<std::mutex> lock(table.mutex);
+  table.datashapes[datashape] = tp.extended();
+  if (!tp.is_builtin()) {
+    table.datashapes_of.emplace(tp.extended(), std::move(datashape));
+  }
+
+  return tp;
+}
+
+size_t ndt::base_type::get_hash() const { return static_cast<size_t>(m_id); }
 
 bool ndt::base_type::is_type_subarray(const type &subarray_tp) const {
   // The default implementation is to check by-value equality.
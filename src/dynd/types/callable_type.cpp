@@ -151,6 +151,12 @@ bool ndt::callable_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::callable_type::get_hash() const {
+  size_t hash = hash_combine(static_cast<size_t>(callable_id), m_return_type.hash());
+  hash = hash_combine(hash, m_pos_tuple.hash());
+  return hash_combine(hash, m_kwd_struct.hash());
+}
+
 void ndt::callable_type::arrmeta_default_construct(char *DYND_UNUSED(arrmeta), bool DYND_UNUSED(blockref_alloc)) const {
 }
 
@@ -5,13 +5,15 @@
 
 #include <cstring>
 #include <map>
-#include <set>
 
 #include <dynd/array_range.hpp>
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/index.hpp>
+#include <dynd/kernels/unique_kernel.hpp>
 #include <dynd/parse_util.hpp>
 #include <dynd/search.hpp>
+#include <dynd/sort.hpp>
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/datashape_parser.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -21,40 +23,12 @@ using namespace std;
 
 namespace {
 
-class sorter {
-  char *m_originptr;
-  intptr_t m_stride;
-  const kernel_single_t m_less;
-  nd::kernel_prefix *m_less_self;
-
-public:
-  sorter(const char *originptr, intptr_t stride, const kernel_single_t less, nd::kernel_prefix *less_self)
-      : m_originptr(const_cast<char *>(originptr)), m_stride(stride), m_less(less), m_less_self(less_self) {}
-
-  bool operator()(intptr_t i, intptr_t j) const {
-    int dst;
-    char *s[2] = {m_originptr + i * m_stride, m_originptr + j * m_stride};
-    m_less(m_less_self, reinterpret_cast<char *>(&dst), s);
-
-    return dst != 0;
-  }
-};
-
-class cmp {
-  const kernel_single_t m_less;
-  nd::kernel_prefix *m_less_self;
-
-public:
-  cmp(const kernel_single_t less, nd::kernel_prefix *less_self) : m_less(less), m_less_self(less_self) {}
-
-  bool operator()(const char *a, const char *b) const {
-    int dst;
-    char *s[2] = {const_cast<char *>(a), const_cast<char *>(b)};
-
-    m_less(m_less_self, reinterpret_cast<char *>(&dst), s);
-    return dst != 0;
-  }
-};
+// Sets the functions a category is hashed and compared with in the table of values
+template <typename T>
+void set_category_key(uint64_t (*&hash)(const char *), bool (*&equal)(const char *, const char *)) {
+  hash = &nd::detail::unique_traits<T>::hash;
+  equal = &nd::detail::unique_traits<T>::equal;
+}
 
 // struct assign_from_commensurate_category {
 //     static void general_kernel(char *dst, intptr_t dst_stride, const char
@@ -106,28 +80,6 @@ public:
 
 } // anoymous namespace
 
-/** This function converts the set of char* pointers into a strided immutable
- * nd::array of the categories */
-static nd::array make_sorted_categories(const set<const char *, cmp> &uniques, const ndt::type &element_tp,
-                                        const char *DYND_UNUSED(arrmeta)) {
-  nd::array categories = nd::empty(uniques.size(), element_tp);
-  nd::kernel_builder k;
-  //  make_assignment_kernel(&k, element_tp, categories.get()->metadata() + sizeof(fixed_dim_type_arrmeta), element_tp,
-  //                       arrmeta, kernel_request_single, &eval::default_eval_context);
-  kernel_single_t fn = k.get()->get_function<kernel_single_t>();
-
-  intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(categories.get()->metadata())->stride;
-  char *dst_ptr = categories.data();
-  for (set<const char *, cmp>::const_iterator it = uniques.begin(); it != uniques.end(); ++it) {
-    char *src = const_cast<char *>(*it);
-    fn(k.get(), dst_ptr, &src);
-    dst_ptr += stride;
-  }
-  categories.get_type().extended()->arrmeta_finalize_buffers(categories.get()->metadata());
-
-  return categories;
-}
-
 ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categories, bool presorted)
     : base_type(id, 4, 4, type_flag_none, 0, 0, 0) {
   intptr_t category_count;
@@ -156,48 +108,16 @@ ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categorie
     }
 
     category_count = categories.get_dim_size();
-    intptr_t categories_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(categories.get()->metadata())->stride;
-
-    const char *categories_element_arrmeta = categories.get()->metadata() + sizeof(fixed_dim_type_arrmeta);
-    nd::kernel_builder k;
-    kernel_single_t fn = k.get()->get_function<kernel_single_t>();
-
-    cmp less(fn, k.get());
-    set<const char *, cmp> uniques(less);
 
+    // The categories are stored in sorted order, so they can also be binary searched
+    m_category_index_to_value = nd::argsort(categories).eval();
     m_value_to_category_index = nd::empty(category_count, make_type<intptr_t>());
-    m_category_index_to_value = nd::empty(category_count, make_type<intptr_t>());
-
-    // create the mapping from indices of (to be lexicographically sorted)
-    // categories to values
-    for (size_t i = 0; i != (size_t)category_count; ++i) {
-      unchecked_fixed_dim_get_rw<intptr_t>(m_category_index_to_value, i) = i;
-      const char *category_value = categories.cdata() + i * categories_stride;
-
-      if (uniques.find(category_value) == uniques.end()) {
-        uniques.insert(category_value);
-      } else {
-        stringstream ss;
-        ss << "categories must be unique: category value ";
-        m_category_tp.print_data(ss, categories_element_arrmeta, category_value);
-        ss << " appears more than once";
-        throw std::runtime_error(ss.str());
-      }
-    }
-    // TODO: Putting everything in a set already caused a sort operation to
-    // occur,
-    //       there's no reason we should need a second sort.
-    std::sort(&unchecked_fixed_dim_get_rw<intptr_t>(m_category_index_to_value, 0),
-              &unchecked_fixed_dim_get_rw<intptr_t>(m_category_index_to_value, category_count),
-              sorter(categories.cdata(), categories_stride, fn, k.get()));
-
     // invert the m_category_index_to_value permutation
     for (intptr_t i = 0; i < category_count; ++i) {
       unchecked_fixed_dim_get_rw<intptr_t>(m_value_to_category_index,
                                            unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i)) = i;
     }
-
-    m_categories = make_sorted_categories(uniques, m_category_tp, categories_element_arrmeta);
+    m_categories = nd::take(categories, m_category_index_to_value).eval();
   }
 
   // Use the number of categories to set which underlying integer storage to use
@@ -210,6 +130,78 @@ ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categorie
   }
   this->m_data_size = m_storage_type.get_data_size();
   this->m_data_alignment = (uint8_t)m_storage_type.get_data_alignment();
+
+  build_value_table();
+}
+
+void ndt::categorical_type::build_value_table() {
+  m_category_hash = NULL;
+  m_category_equal = NULL;
+  switch (m_category_tp.get_id()) {
+  case bool_id:
+    set_category_key<bool1>(m_category_hash, m_category_equal);
+    break;
+  case int8_id:
+    set_category_key<int8_t>(m_category_hash, m_category_equal);
+    break;
+  case int16_id:
+    set_category_key<int16_t>(m_category_hash, m_category_equal);
+    break;
+  case int32_id:
+    set_category_key<int32_t>(m_category_hash, m_category_equal);
+    break;
+  case int64_id:
+    set_category_key<int64_t>(m_category_hash, m_category_equal);
+    break;
+  case uint8_id:
+    set_category_key<uint8_t>(m_category_hash, m_category_equal);
+    break;
+  case uint16_id:
+    set_category_key<uint16_t>(m_category_hash, m_category_equal);
+    break;
+  case uint32_id:
+    set_category_key<uint32_t>(m_category_hash, m_category_equal);
+    break;
+  case uint64_id:
+    set_category_key<uint64_t>(m_category_hash, m_category_equal);
+    break;
+  case float32_id:
+    set_category_key<float>(m_category_hash, m_category_equal);
+    break;
+  case float64_id:
+    set_category_key<double>(m_category_hash, m_category_equal);
+    break;
+  case string_id:
+    set_category_key<dynd::string>(m_category_hash, m_category_equal);
+    break;
+  default:
+    // Other categories are looked up by binary search
+    return;
+  }
+
+  size_t category_count = get_category_count();
+  size_t table_size = 1;
+  while (table_size < 2 * category_count) {
+    table_size *= 2;
+  }
+  m_value_table.assign(table_size, -1);
+
+  size_t mask = table_size - 1;
+  for (size_t value = 0; value < category_count; ++value) {
+    const char *category = get_category_data_from_value(static_cast<uint32_t>(value));
+    size_t i = m_category_hash(category) & mask;
+    for (intptr_t j = m_value_table[i]; j != -1; j = m_value_table[i]) {
+      if (m_category_equal(get_category_data_from_value(static_cast<uint32_t>(j)), category)) {
+        stringstream ss;
+        ss << "categories must be unique: category value ";
+        m_category_tp.print_data(ss, get_category_arrmeta(), category);
+        ss << " appears more than once";
+        throw std::runtime_error(ss.str());
+      }
+      i = (i + 1) & mask;
+    }
+    m_value_table[i] = value;
+  }
 }
 
 void ndt::categorical_type::print_data(std::ostream &o, const char *DYND_UNUSED(arrmeta), const char *data) const {
@@ -262,22 +254,35 @@ void ndt::categorical_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_s
 }
 
 uint32_t ndt::categorical_type::get_value_from_category(const char *category_arrmeta, const char *category_data) const {
-  type dst_tp = make_type<intptr_t>();
-  type src_tp[2] = {m_categories.get_type(), m_category_tp};
-  const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
-  char *src_data[2] = {const_cast<char *>(m_categories.cdata()), const_cast<char *>(category_data)};
-  intptr_t i =
-      nd::binary_search->call(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL, std::map<std::string, ndt::type>())
-          .as<intptr_t>();
-  if (i < 0) {
+  intptr_t value;
+  if (!m_value_table.empty()) {
+    size_t mask = m_value_table.size() - 1;
+    size_t i = m_category_hash(category_data) & mask;
+    for (value = m_value_table[i];
+         value != -1 && !m_category_equal(get_category_data_from_value(static_cast<uint32_t>(value)), category_data);
+         value = m_value_table[i]) {
+      i = (i + 1) & mask;
+    }
+  } else {
+    type dst_tp = make_type<intptr_t>();
+    type src_tp[2] = {m_categories.get_type(), m_category_tp};
+    const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
+    char *src_data[2] = {const_cast<char *>(m_categories.cdata()), const_cast<char *>(category_data)};
+    intptr_t i =
+        nd::binary_search->call(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL, std::map<std::string, ndt::type>())
+            .as<intptr_t>();
+    value = (i < 0) ? -1 : unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
+  }
+
+  if (value < 0) {
     stringstream ss;
     ss << "Unrecognized category value ";
     m_category_tp.print_data(ss, category_arrmeta, category_data);
     ss << " assigning to dynd type " << type(this, true);
     throw std::runtime_error(ss.str());
-  } else {
-    return (uint32_t)unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
   }
+
+  return static_cast<uint32_t>(value);
 }
 
 uint32_t ndt::categorical_type::get_value_from_category(const nd::array &category) const {
@@ -291,15 +296,33 @@ uint32_t ndt::categorical_type::get_value_from_category(const nd::array &categor
     c.assign(category);
   }
 
-  intptr_t i = nd::binary_search(m_categories, c).as<intptr_t>();
-  if (i < 0) {
-    stringstream ss;
-    ss << "Unrecognized category value ";
-    m_category_tp.print_data(ss, c.get()->metadata(), c.data());
-    ss << " assigning to dynd type " << type(this, true);
-    throw std::runtime_error(ss.str());
-  } else {
-    return (uint32_t)unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
+  return get_value_from_category(c.get()->metadata(), c.cdata());
+}
+
+namespace {
+
+template <typename StorageType>
+void encode_values(const ndt::categorical_type *tp, char *dst, intptr_t dst_stride, const char *src_arrmeta,
+                   const char *src, intptr_t src_stride, size_t count) {
+  for (size_t i = 0; i < count; ++i, dst += dst_stride, src += src_stride) {
+    *reinterpret_cast<StorageType *>(dst) = static_cast<StorageType>(tp->get_value_from_category(src_arrmeta, src));
+  }
+}
+
+} // anonymous namespace
+
+void ndt::categorical_type::encode(char *dst, intptr_t dst_stride, const char *src_arrmeta, const char *src,
+                                   intptr_t src_stride, size_t count) const {
+  switch (m_storage_type.get_id()) {
+  case uint8_id:
+    encode_values<uint8_t>(this, dst, dst_stride, src_arrmeta, src, src_stride, count);
+    break;
+  case uint16_id:
+    encode_values<uint16_t>(this, dst, dst_stride, src_arrmeta, src, src_stride, count);
+    break;
+  default:
+    encode_values<uint32_t>(this, dst, dst_stride, src_arrmeta, src, src_stride, count);
+    break;
   }
 }
 
@@ -356,6 +379,21 @@ bool ndt::categorical_type::operator==(const base_type &rhs) const {
   return true;
 }
 
+size_t ndt::categorical_type::get_hash() const {
+  size_t category_count = get_category_count();
+  size_t hash = hash_combine(hash_combine(static_cast<size_t>(categorical_id), m_category_tp.hash()), category_count);
+
+  // Categories that can't be hashed are told apart by operator== alone
+  if (m_category_hash != NULL) {
+    intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(m_categories.get()->metadata())->stride;
+    for (size_t i = 0; i < category_count; ++i) {
+      hash = hash_combine(hash, static_cast<size_t>(m_category_hash(m_categories.cdata() + i * stride)));
+    }
+  }
+
+  return hash;
+}
+
 void ndt::categorical_type::arrmeta_default_construct(char *DYND_UNUSED(arrmeta),
                                                       bool DYND_UNUSED(blockref_alloc)) const {
   // Data is stored as uint##, no arrmeta to process
@@ -380,28 +418,12 @@ ndt::type ndt::factor_categorical(const nd::array &values) {
   // TODO: Some cases where we don't want to do this?
   nd::array values_eval = values.eval();
 
-  intptr_t dim_size, stride;
-  type el_tp;
-  const char *el_arrmeta;
-  values_eval.get_type().get_as_strided(values_eval.get()->metadata(), &dim_size, &stride, &el_tp, &el_arrmeta);
-
-  nd::kernel_builder k;
-  kernel_single_t fn = k.get()->get_function<kernel_single_t>();
-
-  cmp less(fn, k.get());
-  set<const char *, cmp> uniques(less);
-
-  for (intptr_t i = 0; i < dim_size; ++i) {
-    const char *data = values_eval.cdata() + i * stride;
-    if (uniques.find(data) == uniques.end()) {
-      uniques.insert(data);
-    }
-  }
-
-  // Copy the values (now sorted and unique) into a new nd::array
-  nd::array categories = make_sorted_categories(uniques, el_tp, el_arrmeta);
+  // The distinct values, in order of first occurrence, which the categorical type then sorts
+  nd::array uniques = nd::unique(values_eval);
+  nd::array categories = nd::empty(uniques.get_dim_size(), values_eval.get_type().get_type_at_dimension(NULL, 1));
+  categories.assign(uniques);
 
-  return make_type<categorical_type>(categories, true);
+  return make_type<categorical_type>(categories);
 }
 
 std::map<std::string, std::pair<ndt::type, const char *>> ndt::categorical_type::get_dynamic_type_properties() const {
@@ -66,6 +66,8 @@ bool ndt::char_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::char_type::get_hash() const { return hash_combine(static_cast<size_t>(char_id), m_encoding); }
+
 // char_type : char | char[encoding]
 ndt::type ndt::char_type::parse_type_args(type_id_t DYND_UNUSED(id), const char *&rbegin, const char *end,
                                           std::map<std::string, ndt::type> &DYND_UNUSED(symtable)) {
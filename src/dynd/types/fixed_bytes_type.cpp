@@ -69,6 +69,10 @@ bool ndt::fixed_bytes_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::fixed_bytes_type::get_hash() const {
+  return hash_combine(hash_combine(static_cast<size_t>(fixed_bytes_id), get_data_size()), get_data_alignment());
+}
+
 ndt::type ndt::fixed_bytes_type::parse_type_args(type_id_t DYND_UNUSED(id), const char *&rbegin, const char *end,
                                                  std::map<std::string, ndt::type> &DYND_UNUSED(symtable)) {
   const char *begin = rbegin;
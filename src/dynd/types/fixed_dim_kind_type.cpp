@@ -94,6 +94,10 @@ bool ndt::fixed_dim_kind_type::operator==(const base_type &rhs) const {
                           m_element_tp == reinterpret_cast<const fixed_dim_kind_type *>(&rhs)->m_element_tp);
 }
 
+size_t ndt::fixed_dim_kind_type::get_hash() const {
+  return hash_combine(static_cast<size_t>(fixed_dim_kind_id), m_element_tp.hash());
+}
+
 void ndt::fixed_dim_kind_type::arrmeta_default_construct(char *DYND_UNUSED(arrmeta),
                                                          bool DYND_UNUSED(blockref_alloc)) const {
   stringstream ss;
@@ -236,6 +236,10 @@ bool ndt::fixed_dim_type::operator==(const base_type &rhs) const {
           m_element_tp == static_cast<const fixed_dim_type *>(&rhs)->m_element_tp);
 }
 
+size_t ndt::fixed_dim_type::get_hash() const {
+  return hash_combine(hash_combine(static_cast<size_t>(fixed_dim_id), m_dim_size), m_element_tp.hash());
+}
+
 void ndt::fixed_dim_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const {
   size_t element_size =
       m_element_tp.is_builtin() ? m_element_tp.get_data_size() : m_element_tp.extended()->get_default_data_size();
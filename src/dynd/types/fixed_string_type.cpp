@@ -131,6 +131,10 @@ bool ndt::fixed_string_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::fixed_string_type::get_hash() const {
+  return hash_combine(hash_combine(static_cast<size_t>(fixed_string_id), m_stringsize), m_encoding);
+}
+
 std::map<std::string, std::pair<ndt::type, const char *>> ndt::fixed_string_type::get_dynamic_type_properties() const
 {
   std::map<std::string, std::pair<ndt::type, const char *>> properties;
@@ -151,6 +151,8 @@ bool ndt::option_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::option_type::get_hash() const { return hash_combine(static_cast<size_t>(option_id), m_value_tp.hash()); }
+
 void ndt::option_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const {
   if (!m_value_tp.is_builtin()) {
     m_value_tp.extended()->arrmeta_default_construct(arrmeta, blockref_alloc);
@@ -165,6 +165,8 @@ bool ndt::pointer_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::pointer_type::get_hash() const { return hash_combine(static_cast<size_t>(pointer_id), m_target_tp.hash()); }
+
 ndt::type ndt::pointer_type::with_replaced_storage_type(const type & /*replacement_tp*/) const {
   throw runtime_error("TODO: implement pointer_type::with_replaced_storage_type");
 }
@@ -3,8 +3,11 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+
 #include <dynd/buffer.hpp>
 #include <dynd/exceptions.hpp>
+#include <dynd/hash_util.hpp>
 #include <dynd/shape_tools.hpp>
 #include <dynd/types/any_kind_type.hpp>
 #include <dynd/types/str_util.hpp>
@@ -25,10 +28,37 @@ void ndt::struct_type::print_data(std::ostream &o, const char *arrmeta, const ch
   o << "]";
 }
 
-intptr_t ndt::struct_type::get_field_index(const std::string &name) const {
-  auto it = std::find(m_field_names.begin(), m_field_names.end(), name);
-  if (it != m_field_names.end()) {
-    return it - m_field_names.begin();
+void ndt::struct_type::build_field_index_table() {
+  size_t table_size = 1;
+  while (table_size < 2 * static_cast<size_t>(m_field_count)) {
+    table_size *= 2;
+  }
+  m_field_index_table.assign(table_size, -1);
+
+  size_t mask = table_size - 1;
+  for (intptr_t i = 0; i < m_field_count; ++i) {
+    const std::string &name = m_field_names[i];
+    // A repeated name keeps the index of its first occurrence
+    if (get_field_index(name.data(), name.size()) != -1) {
+      continue;
+    }
+    size_t j = hash_bytes(name.data(), name.size()) & mask;
+    while (m_field_index_table[j] != -1) {
+      j = (j + 1) & mask;
+    }
+    m_field_index_table[j] = i;
+  }
+}
+
+intptr_t ndt::struct_type::get_field_index(const char *name, size_t size) const {
+  size_t mask = m_field_index_table.size() - 1;
+  size_t j = hash_bytes(name, size) & mask;
+  for (intptr_t i = m_field_index_table[j]; i != -1; i = m_field_index_table[j]) {
+    const std::string &field_name = m_field_names[i];
+    if (field_name.size() == size && memcmp(field_name.data(), name, size) == 0) {
+      return i;
+    }
+    j = (j + 1) & mask;
   }
 
   return -1;
@@ -168,6 +198,16 @@ bool ndt::struct_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::struct_type::get_hash() const {
+  size_t hash = hash_combine(static_cast<size_t>(struct_id), m_variadic);
+  for (size_t i = 0; i < m_field_types.size(); ++i) {
+    hash = hash_combine(hash, m_field_types[i].hash());
+    hash = hash_combine(hash, std::hash<std::string>()(m_field_names[i]));
+  }
+
+  return hash;
+}
+
 void ndt::struct_type::arrmeta_debug_print(const char *arrmeta, std::ostream &o, const std::string &indent) const {
   const size_t *offsets = reinterpret_cast<const size_t *>(arrmeta);
   o << indent << "struct arrmeta\n";
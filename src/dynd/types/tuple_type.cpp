@@ -254,6 +254,15 @@ bool ndt::tuple_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::tuple_type::get_hash() const {
+  size_t hash = hash_combine(static_cast<size_t>(tuple_id), m_variadic);
+  for (const type &field_tp : m_field_types) {
+    hash = hash_combine(hash, field_tp.hash());
+  }
+
+  return hash;
+}
+
 void ndt::tuple_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const {
   uintptr_t *data_offsets = reinterpret_cast<uintptr_t *>(arrmeta);
   const vector<type> &field_tps = get_field_types();
@@ -60,6 +60,10 @@ bool ndt::typevar_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::typevar_type::get_hash() const {
+  return hash_combine(static_cast<size_t>(typevar_id), std::hash<std::string>()(m_name));
+}
+
 void ndt::typevar_type::arrmeta_default_construct(char *DYND_UNUSED(arrmeta), bool DYND_UNUSED(blockref_alloc)) const {
   throw type_error("Cannot store data of typevar type");
 }
@@ -307,6 +307,10 @@ bool ndt::var_dim_type::operator==(const base_type &rhs) const {
   }
 }
 
+size_t ndt::var_dim_type::get_hash() const {
+  return hash_combine(static_cast<size_t>(var_dim_id), m_element_tp.hash());
+}
+
 void ndt::var_dim_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const {
   size_t element_size =
       m_element_tp.is_builtin() ? m_element_tp.get_data_size() : m_element_tp.extended()->get_default_data_size();
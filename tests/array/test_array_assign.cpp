@@ -13,6 +13,7 @@
 #include <dynd/assignment.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/types/categorical_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -215,6 +216,42 @@ TYPED_TEST_P(ArrayAssign, ScalarAssignment_Uint64) {
   EXPECT_EQ(20000000000ULL, TestFixture::First::Dereference(ptr_u64));
 }
 
+TEST(ArrayAssign, Categorical) {
+  ndt::type tp = ndt::make_type<ndt::categorical_type>(nd::array{"foo", "bar", "baz"});
+  EXPECT_EQ(categorical_id, tp.get_id());
+  EXPECT_EQ(ndt::make_type<uint8_t>(), tp.extended<ndt::categorical_type>()->get_storage_type());
+  EXPECT_EQ(1u, tp.extended<ndt::categorical_type>()->get_value_from_category(nd::array("bar")));
+
+  nd::array a = nd::empty(5, tp);
+  a.assign(nd::array{"baz", "foo", "baz", "bar", "foo"});
+  const uint8_t values[5] = {2, 0, 2, 1, 0};
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(values[i], *reinterpret_cast<const uint8_t *>(a.cdata() + i));
+  }
+  EXPECT_THROW(a.assign(nd::array{"baz", "foo", "qux", "bar", "foo"}), runtime_error);
+  EXPECT_THROW(ndt::make_type<ndt::categorical_type>(nd::array{"foo", "bar", "foo"}), runtime_error);
+  EXPECT_EQ(2u, ndt::factor_categorical(nd::array{"foo", "bar", "foo"})
+                    .extended<ndt::categorical_type>()
+                    ->get_category_count());
+
+  // Values of another type are converted to the category type first
+  vector<int32_t> categories(1000);
+  for (int i = 0; i < 1000; ++i) {
+    categories[i] = 1000 - 7 * i;
+  }
+  tp = ndt::make_type<ndt::categorical_type>(nd::array(categories));
+  EXPECT_EQ(ndt::make_type<uint16_t>(), tp.extended<ndt::categorical_type>()->get_storage_type());
+  nd::array b = nd::empty(3000, ndt::make_type<int64_t>());
+  for (int i = 0; i < 3000; ++i) {
+    b(i).assign(categories[(i * 13) % 1000]);
+  }
+  a = nd::empty(3000, tp);
+  a.assign(b);
+  for (int i = 0; i < 3000; ++i) {
+    EXPECT_EQ((i * 13) % 1000, *reinterpret_cast<const uint16_t *>(a.cdata() + 2 * i));
+  }
+}
+
 #if !(defined(_WIN32) && !defined(_M_X64)) // TODO: How to mark as expected failures in googletest?
 
 TYPED_TEST_P(ArrayAssign, ScalarAssignment_Uint64_LargeNumbers) {
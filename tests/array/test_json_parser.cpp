@@ -6,11 +6,18 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
 #include <dynd/callable.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/json_structural_index.hpp>
 #include <dynd/parse.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
@@ -108,6 +115,48 @@ TEST(JSONParser, BuiltinsFromFloat) {
   EXPECT_EQ(1.5e2, n.as<double>());
 }
 
+TEST(JSONParser, FloatRounding) {
+  EXPECT_EQ(0.1, parse_json(ndt::make_type<double>(), "0.1").as<double>());
+  EXPECT_EQ(0.1f, parse_json(ndt::make_type<float>(), "0.1").as<float>());
+  EXPECT_EQ(-1.25e-300, parse_json(ndt::make_type<double>(), "-1.25e-300").as<double>());
+  EXPECT_EQ(1e23, parse_json(ndt::make_type<double>(), "1e23").as<double>());
+
+  // Limits, subnormals, underflow and overflow
+  EXPECT_EQ(numeric_limits<double>::max(), parse<double>(std::string("1.7976931348623157e308")));
+  EXPECT_EQ(numeric_limits<double>::min(), parse<double>(std::string("2.2250738585072014e-308")));
+  EXPECT_EQ(numeric_limits<double>::denorm_min(), parse<double>(std::string("4.9406564584124654e-324")));
+  EXPECT_EQ(0.0, parse<double>(std::string("2.4703282292062327e-324")));
+  EXPECT_EQ(numeric_limits<double>::denorm_min(), parse<double>(std::string("2.4703282292062328e-324")));
+  EXPECT_EQ(0.0, parse<double>(std::string("1e-400")));
+  EXPECT_TRUE(std::isinf(parse<double>(std::string("1e400"))));
+  EXPECT_EQ(0.0, parse<double>(std::string("0e999999999999")));
+  EXPECT_EQ(numeric_limits<float>::max(), parse<float>(std::string("3.4028235e38")));
+  EXPECT_TRUE(std::isinf(parse<float>(std::string("3.4028236e38"))));
+  EXPECT_EQ(numeric_limits<float>::denorm_min(), parse<float>(std::string("1.4e-45")));
+
+  // Exactly halfway between two values rounds to even, and anything past halfway rounds up,
+  // however many digits it takes to tell
+  EXPECT_EQ(9007199254740992.0, parse<double>(std::string("9007199254740993")));
+  EXPECT_EQ(9007199254740996.0, parse<double>(std::string("9007199254740995")));
+  EXPECT_EQ(9007199254740994.0, parse<double>(std::string("9007199254740993.0000000000000000000000000000001")));
+  EXPECT_EQ(9007199254740992.0, parse<double>(std::string("9007199254740992.9999999999999999999999999999999")));
+  EXPECT_EQ(1.0f, parse<float>(std::string("1.000000059604644775390625")));
+  EXPECT_EQ(nextafterf(1.0f, 2.0f), parse<float>(std::string("1.00000005960464477539062501")));
+
+  EXPECT_EQ(0.5, parse<double>(std::string(".5")));
+  EXPECT_EQ(5.0, parse<double>(std::string("5.")));
+  EXPECT_EQ(3.0, parse<double>(std::string("+3")));
+  EXPECT_THROW(parse<double>(std::string(".")), invalid_argument);
+  EXPECT_THROW(parse<double>(std::string("1e+")), invalid_argument);
+  EXPECT_THROW(parse<double>(std::string("1.2.3")), invalid_argument);
+  EXPECT_THROW(parse_json(ndt::make_type<double>(), "1.5x"), invalid_argument);
+
+  // Only the characters in the range are parsed
+  const char *s = "2.5e1234";
+  EXPECT_EQ(2.5, parse<double>(s, s + 3));
+  EXPECT_EQ(2.5, parse<double>(s, s + 3, nocheck));
+}
+
 TEST(JSONParser, Struct) {
   nd::array n;
   ndt::type sdt = ndt::make_type<ndt::struct_type>({{ndt::make_type<int>(), "id"},
@@ -222,15 +271,208 @@ TEST(JSON, ParserWithMissingValue) {
   EXPECT_TRUE(a.p("y").is_na());
 }
 
-/*
-TEST(JSON, DiscoverBool)
-{
+TEST(JSONParser, StructuralIndex) {
+  std::string json = "{\"a\": [10, \"x,]\\\"{\"], \"b\" :true}";
+  json::structural_index index(json.data(), json.data() + json.size());
+
+  std::string structurals;
+  for (size_t i = 0; i < index.size(); ++i) {
+    structurals += json[index.positions()[i]];
+  }
+  EXPECT_EQ("{\":[1,\"],\":t}", structurals);
+  EXPECT_EQ(json.size(), index.positions()[index.size()]);
+}
+
+TEST(JSONParser, LongListOfStruct) {
+  // Enough records that strings, escapes and numbers straddle the 64-byte blocks of the index
+  std::stringstream ss;
+  ss << "[";
+  for (int i = 0; i < 500; ++i) {
+    ss << (i == 0 ? "" : ",\n") << "{\"id\": " << i << ", \"name\": \"n" << i << " \\\"[{,:}]\\\\\", "
+       << "\"extra\": {\"x\": [1, \"]\"]}, \"tags\": [\"t\", \"" << std::string(i % 70, 'z') << "\"]}";
+  }
+  ss << "]";
+  std::string json = ss.str();
+
+  nd::array a = parse_json(ndt::type("500 * {id: int32, name: string, tags: var * string}"), json.c_str());
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(i, a(i, 0).as<int>());
+    std::stringstream name;
+    name << "n" << i << " \"[{,:}]\\";
+    EXPECT_EQ(name.str(), a(i, 1).as<std::string>());
+    EXPECT_EQ(2, a(i, 2).get_dim_size());
+    EXPECT_EQ(std::string(i % 70, 'z'), a(i, 2, 1).as<std::string>());
+  }
+
+  // An unterminated string, and text after the value
+  EXPECT_THROW(parse_json(ndt::type("2 * string"), "[\"a\", \"b]"), invalid_argument);
+  EXPECT_THROW(parse_json(ndt::type("2 * int32"), "[1, 2] 3"), invalid_argument);
+  EXPECT_THROW(parse_json(ndt::type("2 * int32"), "[1 2]"), invalid_argument);
+}
+
+TEST(JSONParser, NDJSONReader) {
+  ndt::type record_tp("{id: int64, name: string, tags: var * string}");
+  std::ostringstream text;
+  for (int i = 0; i < 8; ++i) {
+    text << "{\"id\": " << i << ", \"name\": \"record " << i << "\", \"tags\": [";
+    for (int j = 0; j < i; ++j) {
+      text << (j == 0 ? "" : ", ") << "\"tag " << j << "\"";
+    }
+    text << "]}" << (i == 3 ? "\r\n\n" : "\n");
+  }
+  std::string str = text.str();
+  // The last line doesn't need a newline
+  str.resize(str.size() - 1);
+  std::istringstream in(str);
+
+  nd::json::ndjson_reader reader(in, record_tp, 3);
+  EXPECT_EQ(ndt::type("3 * {id: int64, name: string, tags: var * string}"), reader.get_batch().get_type());
+  const char *batch_data = reader.get_batch().cdata();
+
+  intptr_t id = 0;
+  for (intptr_t expected_count : {3, 3, 2, 0}) {
+    intptr_t count = reader.read();
+    ASSERT_EQ(expected_count, count);
+    EXPECT_EQ(batch_data, reader.get_batch().cdata());
+    for (intptr_t i = 0; i < count; ++i, ++id) {
+      nd::array record = reader.get_batch()(i);
+      EXPECT_EQ(id, record(0).as<int64_t>());
+      EXPECT_EQ("record " + std::to_string(id), record(1).as<std::string>());
+      ASSERT_EQ(id, record(2).get_dim_size());
+      for (intptr_t j = 0; j < id; ++j) {
+        EXPECT_EQ("tag " + std::to_string(j), record(2)(j).as<std::string>());
+      }
+    }
+  }
+  EXPECT_EQ(8, id);
+  // Including the blank line
+  EXPECT_EQ(9, reader.get_line());
+
+  std::istringstream bad_in("[1, 2]\n[3, 4]\n[5, x]\n");
+  nd::json::ndjson_reader bad_reader(bad_in, ndt::type("2 * int32"), 4);
+  try {
+    bad_reader.read();
+    FAIL() << "expected an invalid_argument exception";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 3, column 5"));
+  }
+
+  EXPECT_THROW(nd::json::ndjson_reader(in, record_tp, 0), invalid_argument);
+}
+
+namespace {
+
+// A record of type {id: int64, name: string, tags: var * string, scores: var * float64}
+std::string make_json_record(int i) {
+  std::ostringstream text;
+  text << "{\"id\": " << i << ", \"name\": \"record " << i << "\", \"tags\": [";
+  for (int j = 0; j < i % 5; ++j) {
+    text << (j == 0 ? "" : ", ") << "\"tag " << j << "\"";
+  }
+  text << "], \"scores\": [";
+  for (int j = 0; j < i % 3; ++j) {
+    text << (j == 0 ? "" : ", ") << i % 100 + 0.25 * j;
+  }
+  text << "]}";
+  return text.str();
+}
+
+void check_json_record(int i, const nd::array &record) {
+  EXPECT_EQ(i, record(0).as<int64_t>());
+  EXPECT_EQ("record " + std::to_string(i), record(1).as<std::string>());
+  ASSERT_EQ(i % 5, record(2).get_dim_size());
+  for (int j = 0; j < i % 5; ++j) {
+    EXPECT_EQ("tag " + std::to_string(j), record(2)(j).as<std::string>());
+  }
+  ASSERT_EQ(i % 3, record(3).get_dim_size());
+  for (int j = 0; j < i % 3; ++j) {
+    EXPECT_EQ(i % 100 + 0.25 * j, record(3)(j).as<double>());
+  }
+}
+
+} // anonymous namespace
+
+TEST(JSONParser, ParallelArrayOfStruct) {
+  const int n = 20000;
+  std::string json = "[";
+  for (int i = 0; i < n; ++i) {
+    json += (i == 0 ? "\n" : ",\n") + make_json_record(i);
+  }
+  json += "\n]\n";
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ndt::type record_tp("{id: int64, name: string, tags: var * string, scores: var * float64}");
+  nd::array a = parse_json(ndt::make_var_dim(record_tp), json.data(), json.data() + json.size(), &ectx);
+  ASSERT_EQ(n, a.get_dim_size());
+  for (int i = 0; i < n; i += 7) {
+    check_json_record(i, a(i));
+  }
+  check_json_record(n - 1, a(n - 1));
+
+  a = parse_json(ndt::make_fixed_dim(n, record_tp), json.data(), json.data() + json.size(), &ectx);
+  for (int i = 0; i < n; i += 7) {
+    check_json_record(i, a(i));
+  }
+
+  // Errors are reported at their line, wherever the chunks were split
+  std::string bad_json = json;
+  bad_json.replace(bad_json.find("\"id\": 12345,"), 13, "\"id\": 12x45,");
+  try {
+    parse_json(ndt::make_var_dim(record_tp), bad_json.data(), bad_json.data() + bad_json.size(), &ectx);
+    FAIL() << "expected an invalid_argument exception";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 12347"));
+  }
+  EXPECT_THROW(parse_json(ndt::make_fixed_dim(n + 1, record_tp), json.data(), json.data() + json.size(), &ectx),
+               invalid_argument);
+}
+
+TEST(JSONParser, ParallelNDJSONReader) {
+  const int n = 20000;
+  std::string text;
+  for (int i = 0; i < n; ++i) {
+    text += make_json_record(i) + "\n";
+  }
+  std::istringstream in(text);
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  nd::json::ndjson_reader reader(
+      in, ndt::type("{id: int64, name: string, tags: var * string, scores: var * float64}"), 8192, &ectx);
+  int id = 0;
+  while (intptr_t count = reader.read()) {
+    for (intptr_t i = 0; i < count; ++i, ++id) {
+      check_json_record(id, reader.get_batch()(i));
+    }
+  }
+  EXPECT_EQ(n, id);
+}
+
+#ifndef WIN32
+TEST(JSONParser, NDJSONReaderFileDescriptor) {
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  const char text[] = "1.5\n-2\n\n1e3\n";
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(text) - 1), write(fds[1], text, sizeof(text) - 1));
+  close(fds[1]);
+
+  nd::json::ndjson_reader reader(fds[0], ndt::make_type<double>(), 16);
+  ASSERT_EQ(3, reader.read());
+  EXPECT_EQ(1.5, reader.get_batch()(0).as<double>());
+  EXPECT_EQ(-2.0, reader.get_batch()(1).as<double>());
+  EXPECT_EQ(1000.0, reader.get_batch()(2).as<double>());
+  EXPECT_EQ(0, reader.read());
+  close(fds[0]);
+}
+#endif
+
+TEST(JSON, DiscoverBool) {
   EXPECT_EQ(ndt::make_type<bool1>(), ndt::json::discover("true"));
   EXPECT_EQ(ndt::make_type<bool1>(), ndt::json::discover("false"));
 }
 
-TEST(JSON, DiscoverInt64)
-{
+TEST(JSON, DiscoverInt64) {
   EXPECT_EQ(ndt::make_type<int64>(), ndt::json::discover("0"));
   EXPECT_EQ(ndt::make_type<int64>(), ndt::json::discover("3"));
   EXPECT_EQ(ndt::make_type<int64>(), ndt::json::discover("11"));
@@ -239,18 +481,16 @@ TEST(JSON, DiscoverInt64)
   EXPECT_EQ(ndt::make_type<int64>(), ndt::json::discover("-5"));
 }
 
-TEST(JSON, DiscoverFloat64)
-{
+TEST(JSON, DiscoverFloat64) {
   EXPECT_EQ(ndt::make_type<float64>(), ndt::json::discover("0.5"));
   EXPECT_EQ(ndt::make_type<float64>(), ndt::json::discover("3.14"));
 }
 
-TEST(JSON, DiscoverString) { EXPECT_EQ(ndt::type(string_id), ndt::json::discover("\"Hello, world!\"")); }
+TEST(JSON, DiscoverString) { EXPECT_EQ(ndt::make_type<ndt::string_type>(), ndt::json::discover("\"Hello, world!\"")); }
 
 TEST(JSON, DiscoverOption) { EXPECT_EQ(ndt::type("?Any"), ndt::json::discover("null")); }
 
-TEST(JSON, DiscoverArray)
-{
+TEST(JSON, DiscoverArray) {
   EXPECT_EQ(ndt::type("()"), ndt::json::discover("[]"));
 
   EXPECT_EQ(ndt::type("1 * int64"), ndt::json::discover("[0]"));
@@ -288,8 +528,7 @@ TEST(JSON, DiscoverArray)
   EXPECT_EQ(ndt::type("2 * var * ?int64"), ndt::json::discover("[[0, null], [2]]"));
 }
 
-TEST(JSON, DiscoverObject)
-{
+TEST(JSON, DiscoverObject) {
   EXPECT_EQ(ndt::type("{}"), ndt::json::discover("{}"));
 
   EXPECT_EQ(ndt::type("{a: int64}"), ndt::json::discover("{\"a\": 3}"));
@@ -297,4 +536,68 @@ TEST(JSON, DiscoverObject)
 
   EXPECT_EQ(ndt::type("{x: float64, y: 3 * int64}"), ndt::json::discover("{\"x\": 3.14, \"y\": [1, 2, 3]}"));
 }
-*/
+
+TEST(JSON, DiscoverObjectsWithMissingFields) {
+  EXPECT_EQ(ndt::type("2 * {a: int64, b: ?string}"), ndt::json::discover("[{\"a\": 1, \"b\": \"x\"}, {\"a\": 2}]"));
+  EXPECT_EQ(ndt::type("2 * {b: float64, a: ?int64}"), ndt::json::discover("[{\"b\": 1}, {\"a\": 2, \"b\": 0.5}]"));
+  EXPECT_EQ(ndt::type("3 * {a: var * int64}"), ndt::json::discover("[{\"a\": []}, {\"a\": [1, 2]}, {\"a\": [3]}]"));
+}
+
+TEST(JSON, DiscoverSample) {
+  std::string json = "[1, 2, 3, 4.5, 5]";
+  EXPECT_EQ(ndt::type("5 * float64"), ndt::json::discover(json));
+  EXPECT_EQ(ndt::type("5 * int64"),
+            ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_first, 3));
+  EXPECT_EQ(ndt::type("5 * float64"),
+            ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_first, 4));
+  EXPECT_EQ(ndt::type("5 * float64"),
+            ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_random, 5));
+
+  // A sample needs at least one element, and the sample size is ignored without one
+  EXPECT_THROW(ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_first, 0),
+               invalid_argument);
+  EXPECT_THROW(ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_random, -5),
+               invalid_argument);
+  EXPECT_EQ(ndt::type("5 * float64"),
+            ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_all, -5));
+
+  // Samples that don't share a type fall back to discovering the whole document
+  json = "[1, \"one\", 2]";
+  EXPECT_EQ(ndt::type("(int64, string, int64)"),
+            ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_first, 2));
+
+  // The elements that aren't sampled are only checked for matching brackets
+  json = "[1, 2, [}]";
+  EXPECT_THROW(ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_first, 1),
+               invalid_argument);
+}
+
+TEST(JSON, DiscoverParallel) {
+  const int n = 20000;
+  std::string json = "[";
+  for (int i = 0; i < n; ++i) {
+    json += (i == 0 ? "\n" : ",\n") + make_json_record(i);
+  }
+  json += "\n]\n";
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ndt::type tp("20000 * {id: int64, name: string, tags: var * string, scores: var * float64}");
+  EXPECT_EQ(tp, ndt::json::discover(json));
+  EXPECT_EQ(tp, ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_all, 0, &ectx));
+  EXPECT_EQ(tp, ndt::json::discover(json.data(), json.data() + json.size(), ndt::json::discover_sample_random, 1000,
+                                    &ectx));
+
+  // The discovered type parses the document
+  nd::array a = parse_json(tp, json.data(), json.data() + json.size(), &ectx);
+  check_json_record(n - 1, a(n - 1));
+
+  std::string bad_json = json;
+  bad_json.replace(bad_json.find("\"id\": 12345,"), 13, "\"id\": 12x45,");
+  try {
+    ndt::json::discover(bad_json.data(), bad_json.data() + bad_json.size(), ndt::json::discover_sample_all, 0, &ectx);
+    FAIL() << "expected an invalid_argument exception";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 12347"));
+  }
+}
@@ -5,59 +5,119 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
 
 #include <dynd/array.hpp>
 #include <dynd/gtest.hpp>
-#include <dynd/types/bytes_type.hpp>
-#include <dynd/types/callable_type.hpp>
+#include <dynd/types/fixed_dim_kind_type.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
-/*
+static void write_file(const char *fn, const void *data, intptr_t size) {
+  ofstream fout(fn, ios::binary);
+  fout.write(reinterpret_cast<const char *>(data), size);
+}
 
-static void write_string_file(const char *fn,
-    const char *data, intptr_t size)
-{
-    ofstream fout(fn, ios::binary);
-    fout.write(data, size);
+static std::string read_file(const char *fn) {
+  ifstream fin(fn, ios::binary);
+  return std::string(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
 }
 
-//  This test fails since the string refactor. We need to redo nd::memmap.
-TEST(ArrayMemMap, SimpleString) {
-    // Create a file with a simple string
-    const char *str = "This is a test of a string.";
-    write_string_file("test.txt", str, strlen(str));
-    // Open the whole file as a memory map
-    nd::array a = nd::memmap("test.txt");
-    // Should have type 'bytes'
-    EXPECT_EQ(ndt::bytes_type::make(1), a.get_type());
-    // If we view it as a string, should still point to the same data
-    nd::array b = a.view_scalars(ndt::string_type::make());
-    EXPECT_EQ(ndt::string_type::make(), b.get_type());
-    EXPECT_EQ(std::string(str), b.as<std::string>());
-
-    // Remap a subset of the file
-    a = nd::array();
-    b = nd::array();
-    a = nd::memmap("test.txt", 5, 7);
-    EXPECT_EQ(ndt::bytes_type::make(1), a.get_type());
-    EXPECT_EQ("is", a.view_scalars(ndt::string_type::make()).as<std::string>());
-
-    // Remap the file using a negative index
-    a = nd::array();
-    a = nd::memmap("test.txt", -7);
-    EXPECT_EQ(ndt::bytes_type::make(1), a.get_type());
-    EXPECT_EQ("string.", a.view_scalars(ndt::string_type::make()).as<std::string>());
-
-#ifdef WIN32
-    _unlink("test.txt");
-#else
-    unlink("test.txt");
-#endif
+TEST(ArrayMemMap, Bytes) {
+  const char *str = "This is a test of a string.";
+  write_file("test_memmap.bin", str, strlen(str));
+
+  // Open the whole file as a memory map
+  nd::array a = nd::memmap("test_memmap.bin");
+  EXPECT_EQ(ndt::make_fixed_dim(strlen(str), ndt::make_type<uint8_t>()), a.get_type());
+  EXPECT_EQ(0, memcmp(str, a.cdata(), strlen(str)));
+  EXPECT_EQ('T', a(0).as<uint8_t>());
+
+  // Remap a subset of the file
+  a = nd::memmap("test_memmap.bin", 5, 7);
+  EXPECT_EQ(ndt::make_fixed_dim(2, ndt::make_type<uint8_t>()), a.get_type());
+  EXPECT_EQ("is", std::string(a.cdata(), 2));
+
+  // Remap the file using a negative index
+  a = nd::memmap("test_memmap.bin", -7);
+  EXPECT_EQ("string.", std::string(a.cdata(), 7));
+
+  // An empty region
+  a = nd::memmap("test_memmap.bin", 7, 7);
+  EXPECT_EQ(ndt::make_fixed_dim(0, ndt::make_type<uint8_t>()), a.get_type());
+
+  a = nd::array();
+  remove("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, Struct) {
+  struct {
+    int64_t a;
+    double b;
+  } values[3] = {{1, 1.5}, {2, 2.5}, {3, 3.5}};
+  write_file("test_memmap.bin", values, sizeof(values));
+
+  ndt::type el_tp =
+      ndt::make_type<ndt::struct_type>({{ndt::make_type<int64_t>(), "a"}, {ndt::make_type<double>(), "b"}});
+
+  // The size of a Fixed dimension comes from the file
+  nd::array a = nd::memmap("test_memmap.bin", ndt::make_type<ndt::fixed_dim_kind_type>(el_tp));
+  EXPECT_EQ(ndt::make_fixed_dim(3, el_tp), a.get_type());
+  EXPECT_FALSE((a.get_flags() & nd::write_access_flag) != 0);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(values[i].a, a(i, 0).as<int64_t>());
+    EXPECT_EQ(values[i].b, a(i, 1).as<double>());
+  }
+
+  // A fixed size type, starting past the first element
+  a = nd::memmap("test_memmap.bin", ndt::make_fixed_dim(2, el_tp), sizeof(values[0]));
+  EXPECT_EQ(ndt::make_fixed_dim(2, el_tp), a.get_type());
+  EXPECT_EQ(2, a(0, 0).as<int64_t>());
+  EXPECT_EQ(3.5, a(1, 1).as<double>());
+
+  a = nd::array();
+  remove("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, ReadWrite) {
+  int32_t values[4] = {1, 2, 3, 4};
+  write_file("test_memmap.bin", values, sizeof(values));
+
+  {
+    nd::array a = nd::memmap("test_memmap.bin", ndt::make_type<ndt::fixed_dim_kind_type>(ndt::make_type<int32_t>()),
+                             0, numeric_limits<intptr_t>::max(), nd::readwrite_access_flags);
+    EXPECT_TRUE((a.get_flags() & nd::write_access_flag) != 0);
+    a(2).assign(30);
+  }
+
+  // The write went to the file
+  values[2] = 30;
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(values), sizeof(values)), read_file("test_memmap.bin"));
+
+  remove("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, Errors) {
+  int32_t values[4] = {1, 2, 3, 4};
+  write_file("test_memmap.bin", values, sizeof(values));
+
+  // Types without a fixed size
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::make_type<ndt::string_type>()), type_error);
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("var * int32")), type_error);
+  // Too few bytes, or a number of bytes that isn't a whole number of elements
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::make_fixed_dim(5, ndt::make_type<int32_t>())), invalid_argument);
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("Fixed * int64"), 8, 12), invalid_argument);
+  // A misaligned offset
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("Fixed * int32"), 2, 14), invalid_argument);
+  // A missing file
+  EXPECT_THROW(nd::memmap("test_memmap_missing.bin"), runtime_error);
+
+  remove("test_memmap.bin");
 }
-*/
@@ -11,6 +11,7 @@
 
 #include <dynd/arithmetic.hpp>
 #include <dynd/array.hpp>
+#include <dynd/comparison.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/index.hpp>
 #include <dynd/json_parser.hpp>
@@ -257,6 +258,31 @@ TEST(Arithmetic, Minus) {
   EXPECT_ARRAY_EQ(nd::array({-0.0, -1.0, -2.0, -3.0, -4.0}), -a);
 }
 
+TEST(Arithmetic, Contiguous) {
+  // Odd sizes leave a remainder after any vectorized part of the loop
+  nd::array a = nd::empty(ndt::type("37 * float64"));
+  nd::array b = nd::empty(ndt::type("37 * int32"));
+  nd::array sum = nd::empty(ndt::type("37 * float64"));
+  nd::array product = nd::empty(ndt::type("37 * int32"));
+  nd::array less = nd::empty(ndt::type("37 * bool"));
+  for (int i = 0; i < 37; ++i) {
+    a(i).assign(0.5 * i);
+    b(i).assign(36 - i);
+    sum(i).assign(0.5 * i + (36 - i));
+    product(i).assign((36 - i) * (36 - i));
+    less(i).assign(0.5 * i < 36 - i);
+  }
+
+  EXPECT_ARRAY_EQ(sum, a + b);
+  EXPECT_ARRAY_EQ(product, b * b);
+  EXPECT_ARRAY_EQ(less, a < b);
+
+  // Strided operands take the generic loop, even though the results are contiguous
+  EXPECT_ARRAY_EQ(sum(irange().by(3)), a(irange().by(3)) + b(irange().by(3)));
+  EXPECT_ARRAY_EQ(product(irange(1, 37, 2)), b(irange(1, 37, 2)) * b(irange(1, 37, 2)));
+  EXPECT_ARRAY_EQ(less(irange().by(2)), a(irange().by(2)) < b(irange().by(2)));
+}
+
 /*
 TEST(Arithmetic, CompoundDiv)
 {
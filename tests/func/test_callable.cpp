@@ -161,6 +161,114 @@ TEST(Callable, Assignment_CallInterface) {
   EXPECT_THROW(af(false), invalid_argument);
 }
 
+TEST(Callable, CallCache) {
+  nd::callable f([](int x, double y) { return 2.0 * x + y; }, "y");
+  nd::call_cache &cache = f->get_call_cache();
+
+  EXPECT_ARRAY_EQ(4.5, f({1}, {{"y", 2.5}}));
+  EXPECT_ARRAY_EQ(6.5, f({2}, {{"y", 2.5}}));
+  EXPECT_EQ(1u, cache.get_stats().misses);
+  EXPECT_EQ(1u, cache.get_stats().hits);
+
+  // A different keyword value is a different signature
+  EXPECT_ARRAY_EQ(7.5, f({2}, {{"y", 3.5}}));
+  EXPECT_EQ(2u, cache.get_stats().misses);
+  EXPECT_EQ(2u, cache.size());
+
+  // The ckernel is reused when the arrmeta is the same
+  nd::array x = 3;
+  nd::array dst = nd::empty(ndt::make_type<double>());
+  f({x}, {{"y", 2.5}, {"dst", dst}});
+  EXPECT_ARRAY_EQ(8.5, dst);
+  x.assign(4);
+  f({x}, {{"y", 2.5}, {"dst", dst}});
+  EXPECT_ARRAY_EQ(10.5, dst);
+  EXPECT_EQ(1u, cache.get_stats().kernel_hits);
+
+  // Least recently used entries are evicted
+  size_t size = cache.size();
+  cache.set_capacity(1);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(size - 1, cache.get_stats().evictions);
+  EXPECT_ARRAY_EQ(7.5, f({2}, {{"y", 3.5}}));
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(size, cache.get_stats().evictions);
+
+  cache.set_capacity(0);
+  cache.reset_stats();
+  EXPECT_ARRAY_EQ(4.5, f({1}, {{"y", 2.5}}));
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(0u, cache.get_stats().hits);
+}
+
+TEST(Callable, Prepare) {
+  nd::callable f([](int x, double y) { return 2.0 * x + y; });
+
+  nd::prepared_call single =
+      f.prepare(ndt::make_type<double>(), {ndt::make_type<int>(), ndt::make_type<double>()});
+  EXPECT_EQ(ndt::make_type<double>(), single.get_dst_type());
+
+  int x = 3;
+  double y = 0.5, dst;
+  char *src[2] = {reinterpret_cast<char *>(&x), reinterpret_cast<char *>(&y)};
+  single(reinterpret_cast<char *>(&dst), src);
+  EXPECT_EQ(6.5, dst);
+  x = 4;
+  single(reinterpret_cast<char *>(&dst), src);
+  EXPECT_EQ(8.5, dst);
+
+  nd::prepared_call strided = f.prepare(ndt::make_type<double>(), {ndt::make_type<int>(), ndt::make_type<double>()},
+                                        {}, kernel_request_strided);
+  int xs[3] = {1, 2, 3};
+  double dsts[3];
+  intptr_t src_stride[2] = {sizeof(int), 0};
+  src[0] = reinterpret_cast<char *>(xs);
+  strided(reinterpret_cast<char *>(dsts), sizeof(double), src, src_stride, 3);
+  EXPECT_EQ(2.5, dsts[0]);
+  EXPECT_EQ(4.5, dsts[1]);
+  EXPECT_EQ(6.5, dsts[2]);
+  EXPECT_THROW(strided(reinterpret_cast<char *>(&dst), src), runtime_error);
+
+  EXPECT_THROW(f.prepare(ndt::type("Any"), {ndt::make_type<int>(), ndt::make_type<double>()}), invalid_argument);
+  EXPECT_THROW(f.prepare(ndt::make_type<double>(), {ndt::type("3 * int32"), ndt::make_type<double>()}),
+               invalid_argument);
+}
+
+TEST(Callable, PrepareKeywords) {
+  // An option keyword that isn't given takes a missing value, as in a call
+  nd::prepared_call assign = nd::assign.prepare(ndt::make_type<int>(), {ndt::make_type<double>()});
+  double src = 7.0;
+  char *src_data = reinterpret_cast<char *>(&src);
+  int dst;
+  assign(reinterpret_cast<char *>(&dst), &src_data);
+  EXPECT_EQ(7, dst);
+
+  nd::prepared_call nocheck =
+      nd::assign.prepare(ndt::make_type<int>(), {ndt::make_type<double>()}, {assign_error_nocheck});
+  src = 2.5;
+  nocheck(reinterpret_cast<char *>(&dst), &src_data);
+  EXPECT_EQ(2, dst);
+
+  // Keywords are checked against the signature
+  nd::callable f([](int x, double y) { return 2.0 * x + y; }, "y");
+  EXPECT_THROW(f.prepare(ndt::make_type<double>(), {ndt::make_type<int>()}), invalid_argument);
+  EXPECT_THROW(f.prepare(ndt::make_type<double>(), {ndt::make_type<int>()}, {nd::array("2.5")}), invalid_argument);
+  EXPECT_THROW(f.prepare(ndt::make_type<double>(), {ndt::make_type<int>()}, {2.5, 1}), invalid_argument);
+  nd::prepared_call g = f.prepare(ndt::make_type<double>(), {ndt::make_type<int>()}, {2.5});
+  int x = 3;
+  char *x_data = reinterpret_cast<char *>(&x);
+  double y;
+  g(reinterpret_cast<char *>(&y), &x_data);
+  EXPECT_EQ(8.5, y);
+
+  // So are the arguments and the destination
+  EXPECT_THROW(f.prepare(ndt::make_type<double>(), {}, {2.5}), invalid_argument);
+  EXPECT_THROW(f.prepare(ndt::make_type<double>(), {ndt::make_type<int>(), ndt::make_type<int>()}, {2.5}),
+               invalid_argument);
+  EXPECT_THROW(f.prepare(ndt::make_type<double>(), {ndt::make_type<float>()}, {2.5}), invalid_argument);
+  EXPECT_THROW(f.prepare(ndt::make_type<int>(), {ndt::make_type<int>()}, {2.5}), invalid_argument);
+}
+
 /*
 #include <llvm/Bitcode/ReaderWriter.h>
 #include <llvm/IR/LLVMContext.h>
@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/statistics.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+void expect_describe(int64_t count, double sum, double min, double max, double mean, double var, const nd::array &res) {
+  EXPECT_EQ(ndt::type("{count: int64, sum: float64, min: float64, max: float64, mean: float64, var: float64}"),
+            res.get_type());
+  EXPECT_EQ(count, res(0).as<int64_t>());
+  EXPECT_DOUBLE_EQ(sum, res(1).as<double>());
+  EXPECT_DOUBLE_EQ(min, res(2).as<double>());
+  EXPECT_DOUBLE_EQ(max, res(3).as<double>());
+  EXPECT_NEAR(mean, res(4).as<double>(), 1e-12 * fabs(mean));
+  EXPECT_NEAR(var, res(5).as<double>(), 1e-6 * fabs(var));
+}
+
+} // unnamed namespace
+
+TEST(Describe, 1D) {
+  expect_describe(1, 2.5, 2.5, 2.5, 2.5, 0.0, nd::describe(nd::array{2.5}));
+  expect_describe(4, 10.0, 1.0, 4.0, 2.5, 1.25, nd::describe(nd::array{3.0, 1.0, 4.0, 2.0}));
+  expect_describe(5, 5.0, -3.0, 7.0, 1.0, 11.6, nd::describe(nd::array{-3, 7, 0, 2, -1}));
+  expect_describe(3, 6.0, 1.0, 3.0, 2.0, 2.0 / 3.0, nd::describe(nd::array{1.0f, 2.0f, 3.0f}));
+}
+
+TEST(Describe, Axes) {
+  nd::array a{{1.0, 2.0, 3.0}, {5.0, 7.0, 9.0}};
+  expect_describe(6, 27.0, 1.0, 9.0, 4.5, 47.5 / 6.0, nd::describe(a));
+
+  nd::array res = nd::describe({a}, {{"axes", {1}}});
+  ASSERT_EQ(2, res.get_dim_size());
+  expect_describe(3, 6.0, 1.0, 3.0, 2.0, 2.0 / 3.0, res(0));
+  expect_describe(3, 21.0, 5.0, 9.0, 7.0, 8.0 / 3.0, res(1));
+
+  res = nd::describe({a}, {{"axes", {0}}});
+  ASSERT_EQ(3, res.get_dim_size());
+  expect_describe(2, 6.0, 1.0, 5.0, 3.0, 4.0, res(0));
+  expect_describe(2, 12.0, 3.0, 9.0, 6.0, 9.0, res(2));
+}
+
+TEST(Describe, Parallel) {
+  size_t nthreads = eval::default_eval_context.nthreads;
+  size_t grain_size = eval::default_eval_context.grain_size;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.grain_size = 8;
+
+  // A large offset makes the naive sum-of-squares variance lose all its digits
+  nd::array a = nd::empty(ndt::type("1000 * float64"));
+  for (int i = 0; i < 1000; ++i) {
+    a(i).assign(1e9 + i % 10);
+  }
+  expect_describe(1000, 1000 * 1e9 + 4500, 1e9, 1e9 + 9, 1e9 + 4.5, 8.25, nd::describe(a));
+
+  eval::default_eval_context.nthreads = nthreads;
+  eval::default_eval_context.grain_size = grain_size;
+}
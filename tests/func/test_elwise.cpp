@@ -4,9 +4,13 @@
 //
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <thread>
 
 #include <dynd/array.hpp>
 #include <dynd/assignment.hpp>
@@ -15,6 +19,7 @@
 #include <dynd/gtest.hpp>
 #include <dynd/index.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/thread_pool.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 
 using namespace std;
@@ -218,6 +223,78 @@ TEST(Elwise, Binary_FixedDim) {
   EXPECT_ARRAY_EQ((nd::array{3, 5, 7}), f({{0, 1, 2}, {3, 4, 5}}, {}));
 }
 
+TEST(Elwise, Binary_MultiDimFixedDim) {
+  nd::callable f = nd::functional::elwise(nd::functional::apply([](int x, int y) { return 10 * x + y; }));
+
+  // Contiguous dimensions are folded into one loop
+  nd::array a{{0, 1, 2}, {3, 4, 5}};
+  nd::array b{{6, 7, 8}, {9, 10, 11}};
+  EXPECT_ARRAY_EQ((nd::array{{6, 17, 28}, {39, 50, 61}}), f(a, b));
+
+  nd::array c{{{0, 1}, {2, 3}}, {{4, 5}, {6, 7}}, {{8, 9}, {10, 11}}};
+  EXPECT_ARRAY_EQ((nd::array{{{0, 11}, {22, 33}}, {{44, 55}, {66, 77}}, {{88, 99}, {110, 121}}}), f(c, c));
+
+  // Fortran order operands are folded too
+  nd::array dst = nd::empty(ndt::type("2 * 3 * int32")).transpose();
+  f({a.transpose(), b.transpose()}, {{"dst", dst}});
+  EXPECT_ARRAY_EQ((nd::array{{6, 39}, {17, 50}, {28, 61}}), dst);
+
+  // Mixed orders and strided slices keep their dimensions
+  EXPECT_ARRAY_EQ((nd::array{{6, 39}, {17, 50}, {28, 61}}), f(a.transpose(), b.transpose()));
+  EXPECT_ARRAY_EQ((nd::array{{6, 28}, {39, 61}}), f(a(irange(), irange().by(2)), b(irange(), irange().by(2))));
+}
+
+TEST(Elwise, Parallel) {
+  nd::callable f = nd::functional::elwise(nd::functional::apply([](int x, int y) { return 10 * x + y; }));
+
+  size_t nthreads = eval::default_eval_context.nthreads;
+  size_t grain_size = eval::default_eval_context.grain_size;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.grain_size = 16;
+
+  nd::array a = nd::empty(ndt::type("1000 * 3 * int32"));
+  nd::array b = nd::empty(ndt::type("1000 * 3 * int32"));
+  nd::array expected = nd::empty(ndt::type("1000 * 3 * int32"));
+  for (int i = 0; i < 1000; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      a(i, j).assign(i);
+      b(i, j).assign(j);
+      expected(i, j).assign(10 * i + j);
+    }
+  }
+  EXPECT_ARRAY_EQ(expected, f(a, b));
+  EXPECT_ARRAY_EQ(expected(irange().by(2)), f(a(irange().by(2)), b(irange().by(2))));
+  EXPECT_ARRAY_EQ(expected.transpose(), f(a.transpose(), b.transpose()));
+
+  // Broadcast operands are shared by every thread
+  EXPECT_ARRAY_EQ(expected(irange(), 1), f(a(irange(), 0), 1));
+
+  // The work is shared out among more than one thread, even where the hardware has one
+  thread_pool::get().reserve(4);
+  std::mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  nd::callable g = nd::functional::elwise(nd::functional::apply([&](int x, int y) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    // Slow enough that the other threads wake up before the calling one is done
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+    return 10 * x + y;
+  }));
+  EXPECT_ARRAY_EQ(expected, g(a, b));
+  EXPECT_LT(1u, thread_ids.size());
+
+  // Nothing is split unless it's asked for
+  eval::default_eval_context.nthreads = 1;
+  thread_ids.clear();
+  EXPECT_ARRAY_EQ(expected, g(a, b));
+  EXPECT_EQ(1u, thread_ids.size());
+
+  eval::default_eval_context.nthreads = nthreads;
+  eval::default_eval_context.grain_size = grain_size;
+}
+
 /*
 // TODO Reenable once there's a convenient way to make the binary callable
 TEST(LiftCallable, Expr_MultiDimVarToVarDim) {
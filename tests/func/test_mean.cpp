@@ -14,9 +14,6 @@
 using namespace std;
 using namespace dynd;
 
-/*
-ToDo: Fix this.
-
 TEST(Mean, 1D)
 {
   EXPECT_ARRAY_EQ(0.0, nd::mean(nd::array{0.0}));
@@ -32,4 +29,10 @@ TEST(Mean, 2D)
   EXPECT_ARRAY_EQ(4.5, nd::mean(nd::array({{9.0, 8.0, 7.0, 6.0, 5.0}, {4.0, 3.0, 2.0, 1.0, 0.0}})));
 }
 
-*/
+TEST(Mean, Axes) {
+  nd::array a{{0.0, 1.0, 2.0}, {3.0, 4.0, 5.0}};
+  EXPECT_ARRAY_EQ((nd::array{1.5, 2.5, 3.5}), nd::mean({a}, {{"axes", {0}}}));
+  EXPECT_ARRAY_EQ((nd::array{1.0, 4.0}), nd::mean({a}, {{"axes", {1}}}));
+  EXPECT_ARRAY_EQ(2.5, nd::mean({a}, {{"summation", summation_kahan}}));
+  EXPECT_THROW(nd::mean(nd::array{1, 2, 3}), invalid_argument);
+}
@@ -10,6 +10,7 @@
 
 #include <dynd/functional.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -182,6 +183,52 @@ TEST(Reduction, BuiltinSum_Lift3D_StridedStridedStrided_ReduceBroadcastReduce) {
                                              {{"axes", {0, 2}}}));
 }
 
+TEST(Reduction, Parallel) {
+  size_t nthreads = eval::default_eval_context.nthreads;
+  size_t grain_size = eval::default_eval_context.grain_size;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.grain_size = 8;
+
+  nd::array a = nd::empty(ndt::type("100 * 30 * float64"));
+  double expected = 0.0;
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      a(i, j).assign(i - j);
+      expected += i - j;
+    }
+  }
+
+  nd::callable f =
+      nd::functional::reduction([] { return 0.0; }, [](const return_wrapper<double> &res, double x) { res += x; });
+  EXPECT_ARRAY_EQ(expected, f(a));
+  EXPECT_ARRAY_EQ(expected, f(a.transpose()));
+  EXPECT_ARRAY_EQ(expected, f(a(irange(), irange(0, 30))));
+  EXPECT_ARRAY_EQ(nd::array({expected}), f({a}, {{"keepdims", true}})(irange(), 0));
+
+  // Partial reductions are not split
+  EXPECT_ARRAY_EQ(f(a(irange(), 3)), f({a}, {{"axes", {0}}})(3));
+
+  // A reduction that does not accumulate into its argument type needs a combiner
+  nd::callable count =
+      nd::functional::reduction([] { return int64_t(0); }, [](const return_wrapper<int64_t> &res, double) { res += 1; },
+                                [](const return_wrapper<int64_t> &res, int64_t x) { res += x; });
+  EXPECT_ARRAY_EQ(int64_t(3000), count(a));
+  EXPECT_ARRAY_EQ(int64_t(100), count(a(irange(), 0)));
+
+  nd::callable g = nd::functional::reduction([] { return 0; },
+                                             [](const return_wrapper<int> &res, int x, int y) { res += max(x, y); });
+  nd::array b = nd::empty(ndt::type("1000 * int32"));
+  nd::array c = nd::empty(ndt::type("1000 * int32"));
+  for (int i = 0; i < 1000; ++i) {
+    b(i).assign(i);
+    c(i).assign(999 - i);
+  }
+  EXPECT_ARRAY_EQ(749500, g(b, c));
+
+  eval::default_eval_context.nthreads = nthreads;
+  eval::default_eval_context.grain_size = grain_size;
+}
+
 TEST(Reduction, Except) {
   // Cannot have a null child
   EXPECT_THROW(nd::functional::reduction([] { return 0; }, nd::callable()), invalid_argument);
@@ -6,10 +6,14 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
 
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
 #include <dynd/sort.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -24,11 +28,241 @@ TEST(Sort, 1D) {
   EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}), a);
 }
 
-/*
-TEST(Unique, 1D)
-{
-  nd::array a{0, 0, 1, 2, 2, 3};
-  nd::unique(a);
-  EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3}), a);
+template <typename T>
+class SortBuiltin : public ::testing::Test {};
+
+typedef ::testing::Types<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float, double>
+    sort_builtin_types;
+
+TYPED_TEST_CASE(SortBuiltin, sort_builtin_types);
+
+template <typename T>
+static vector<T> make_sort_values(size_t n) {
+  // Values of both signs, repeated, and spanning every byte of the type
+  vector<T> values(n);
+  uint64_t x = 12345;
+  for (size_t i = 0; i < n; ++i) {
+    x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    values[i] = static_cast<T>(static_cast<int64_t>(x >> (64 - 8 * sizeof(T))) - (i % 3 == 0 ? 100 : 0));
+  }
+  return values;
+}
+
+template <typename T>
+static void expect_sorted(const vector<T> &expected, const nd::array &a) {
+  ASSERT_EQ(static_cast<intptr_t>(expected.size()), a.get_dim_size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], a(i).as<T>()) << "at index " << i;
+  }
+}
+
+TYPED_TEST(SortBuiltin, Contiguous) {
+  for (size_t n : {0, 1, 2, 10, 300, 5000}) {
+    vector<TypeParam> values = make_sort_values<TypeParam>(n);
+    nd::array a = nd::empty(ndt::make_fixed_dim(n, ndt::make_type<TypeParam>()));
+    if (n > 0) {
+      memcpy(a.data(), values.data(), n * sizeof(TypeParam));
+    }
+
+    nd::sort(a);
+    sort(values.begin(), values.end());
+    expect_sorted(values, a);
+  }
+}
+
+TYPED_TEST(SortBuiltin, Strided) {
+  size_t n = 1000;
+  vector<TypeParam> values = make_sort_values<TypeParam>(2 * n);
+  nd::array a = nd::empty(ndt::make_fixed_dim(2 * n, ndt::make_type<TypeParam>()));
+  memcpy(a.data(), values.data(), 2 * n * sizeof(TypeParam));
+
+  // Sorting every other element leaves the rest in place
+  nd::sort(a(irange().by(2)));
+  vector<TypeParam> expected(n);
+  for (size_t i = 0; i < n; ++i) {
+    expected[i] = values[2 * i];
+  }
+  sort(expected.begin(), expected.end());
+  for (size_t i = 0; i < n; ++i) {
+    values[2 * i] = expected[i];
+  }
+  expect_sorted(values, a);
+}
+
+/**
+ * Sets the default eval context's thread count and grain size, restoring them on
+ * destruction so that a failed assertion can't leak them into later tests.
+ */
+class parallel_sort_scope {
+  size_t m_nthreads;
+  size_t m_grain_size;
+
+public:
+  parallel_sort_scope(size_t nthreads, size_t grain_size)
+      : m_nthreads(eval::default_eval_context.nthreads), m_grain_size(eval::default_eval_context.grain_size) {
+    eval::default_eval_context.nthreads = nthreads;
+    eval::default_eval_context.grain_size = grain_size;
+  }
+
+  ~parallel_sort_scope() {
+    eval::default_eval_context.nthreads = m_nthreads;
+    eval::default_eval_context.grain_size = m_grain_size;
+  }
+};
+
+TYPED_TEST(SortBuiltin, Parallel) {
+  parallel_sort_scope scope(4, 100);
+
+  for (size_t n : {300, 1001, 20000}) {
+    vector<TypeParam> values = make_sort_values<TypeParam>(n);
+    nd::array a = nd::empty(ndt::make_fixed_dim(n, ndt::make_type<TypeParam>()));
+    memcpy(a.data(), values.data(), n * sizeof(TypeParam));
+
+    nd::sort(a);
+    sort(values.begin(), values.end());
+    expect_sorted(values, a);
+  }
+}
+
+TEST(Sort, NaN) {
+  double nan = numeric_limits<double>::quiet_NaN();
+  nd::array a{3.0, nan, -1.0, nan, 2.0, -numeric_limits<double>::infinity(), 0.0};
+  nd::sort(a);
+  EXPECT_EQ(-numeric_limits<double>::infinity(), a(0).as<double>());
+  EXPECT_EQ(-1.0, a(1).as<double>());
+  EXPECT_EQ(0.0, a(2).as<double>());
+  EXPECT_EQ(2.0, a(3).as<double>());
+  EXPECT_EQ(3.0, a(4).as<double>());
+  EXPECT_TRUE(std::isnan(a(5).as<double>()));
+  EXPECT_TRUE(std::isnan(a(6).as<double>()));
+
+  // The merges of a parallel sort keep the NaNs last
+  parallel_sort_scope scope(4, 4);
+
+  nd::array b = nd::empty(ndt::make_fixed_dim(40, ndt::make_type<float>()));
+  for (int i = 0; i < 40; ++i) {
+    b(i).assign((i % 5 == 0) ? numeric_limits<float>::quiet_NaN() : static_cast<float>(40 - i));
+  }
+  nd::sort(b);
+  for (int i = 0; i < 31; ++i) {
+    EXPECT_LT(b(i).as<float>(), b(i + 1).as<float>());
+  }
+  for (int i = 32; i < 40; ++i) {
+    EXPECT_TRUE(std::isnan(b(i).as<float>()));
+  }
+}
+
+TYPED_TEST(SortBuiltin, Argsort) {
+  for (size_t n : {0, 1, 10, 300, 5000}) {
+    vector<TypeParam> values = make_sort_values<TypeParam>(n);
+    nd::array a = nd::empty(ndt::make_fixed_dim(n, ndt::make_type<TypeParam>()));
+    if (n > 0) {
+      memcpy(a.data(), values.data(), n * sizeof(TypeParam));
+    }
+
+    nd::array index = nd::argsort(a);
+    EXPECT_EQ(ndt::make_fixed_dim(n, ndt::make_type<intptr_t>()), index.get_type());
+
+    // Integer keys are always sorted stably
+    vector<intptr_t> expected(n);
+    iota(expected.begin(), expected.end(), 0);
+    stable_sort(expected.begin(), expected.end(), [&](intptr_t i, intptr_t j) { return values[i] < values[j]; });
+    if (std::is_integral<TypeParam>::value) {
+      expect_sorted(expected, index);
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(values[expected[i]], values[index(i).as<intptr_t>()]);
+      }
+    }
+  }
+}
+
+TEST(Argsort, Stable) {
+  nd::array a{2.5, 1.0, 2.5, std::numeric_limits<double>::quiet_NaN(), 1.0, 0.5};
+  nd::array index = nd::argsort({a}, {{"stable", true}});
+  intptr_t expected[6] = {5, 1, 4, 0, 2, 3};
+  EXPECT_ARRAY_EQ(expected, index);
+
+  // Equal keys keep their order under a stable sort of a type without a builtin path
+  a = {"b", "a", "c", "a", "b"};
+  index = nd::argsort({a}, {{"stable", true}});
+  intptr_t expected_strings[5] = {1, 3, 0, 4, 2};
+  EXPECT_ARRAY_EQ(expected_strings, index);
+
+  index = nd::argsort(a);
+  EXPECT_ARRAY_EQ((nd::array{"a", "a", "b", "b", "c"}), nd::take(a, index));
+}
+
+TEST(Argsort, Strided) {
+  nd::array a{9, 100, 3, 100, 5, 100, 1};
+  nd::array index = nd::argsort(a(irange().by(2)));
+  intptr_t expected[4] = {3, 1, 2, 0};
+  EXPECT_ARRAY_EQ(expected, index);
+}
+
+template <typename T>
+static void expect_var_eq(const vector<T> &expected, const nd::array &a) {
+  ASSERT_EQ(static_cast<intptr_t>(expected.size()), a.get_dim_size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i], a(i).as<T>()) << "at index " << i;
+  }
+}
+
+TEST(Unique, 1D) {
+  nd::array a{3, 0, 3, 1, 2, 2, 3, 0};
+  nd::array b = nd::unique(a);
+  EXPECT_EQ(ndt::type("var * int32"), b.get_type());
+  expect_var_eq<int>({3, 0, 1, 2}, b);
+  // The input is left as it was
+  EXPECT_ARRAY_EQ((nd::array{3, 0, 3, 1, 2, 2, 3, 0}), a);
+
+  a = nd::empty(ndt::make_fixed_dim(0, ndt::make_type<int64_t>()));
+  EXPECT_EQ(0, nd::unique(a).get_dim_size());
+
+  a = {"b", "a", "b", "", "a"};
+  expect_var_eq<std::string>({"b", "a", ""}, nd::unique(a));
+
+  double nan = numeric_limits<double>::quiet_NaN();
+  a = {1.0, -0.0, nan, 0.0, -nan, 1.0};
+  b = nd::unique(a);
+  ASSERT_EQ(3, b.get_dim_size());
+  EXPECT_EQ(1.0, b(0).as<double>());
+  EXPECT_EQ(0.0, b(1).as<double>());
+  EXPECT_TRUE(std::isnan(b(2).as<double>()));
+}
+
+TEST(Unique, CountsInverse) {
+  nd::array a{"x", "y", "x", "z", "x", "y"};
+
+  nd::array b = nd::unique({a}, {{"counts", true}});
+  EXPECT_EQ(ndt::type("{values: var * string, counts: var * intptr}"), b.get_type());
+  expect_var_eq<std::string>({"x", "y", "z"}, b(0));
+  expect_var_eq<intptr_t>({3, 2, 1}, b(1));
+
+  b = nd::unique({a}, {{"counts", true}, {"inverse", true}});
+  EXPECT_EQ(ndt::type("{values: var * string, counts: var * intptr, inverse: 6 * intptr}"), b.get_type());
+  expect_var_eq<intptr_t>({3, 2, 1}, b(1));
+  intptr_t inverse[6] = {0, 1, 0, 2, 0, 1};
+  EXPECT_ARRAY_EQ(inverse, b(2));
+
+  b = nd::unique({a}, {{"inverse", true}});
+  EXPECT_EQ(ndt::type("{values: var * string, inverse: 6 * intptr}"), b.get_type());
+  EXPECT_ARRAY_EQ(inverse, b(1));
+}
+
+TEST(Unique, HighCardinality) {
+  // Enough distinct values to grow the hash table many times
+  size_t n = 100000;
+  nd::array a = nd::empty(ndt::make_fixed_dim(2 * n, ndt::make_type<int64_t>()));
+  int64_t *data = reinterpret_cast<int64_t *>(a.data());
+  for (size_t i = 0; i < 2 * n; ++i) {
+    data[i] = static_cast<int64_t>((i % n) * 7919);
+  }
+
+  nd::array b = nd::unique({a}, {{"counts", true}});
+  ASSERT_EQ(static_cast<intptr_t>(n), b(0).get_dim_size());
+  for (size_t i = 0; i < n; i += 997) {
+    EXPECT_EQ(static_cast<int64_t>(i * 7919), b(0)(i).as<int64_t>());
+    EXPECT_EQ(2, b(1)(i).as<intptr_t>());
+  }
 }
-*/
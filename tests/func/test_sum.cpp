@@ -15,7 +15,6 @@
 using namespace std;
 using namespace dynd;
 
-/*
 TEST(Sum, 1D)
 {
   // int32
@@ -54,11 +53,36 @@ TEST(Sum, 1D)
                   nd::sum(nd::array{dynd::complex<double>(1.25, -2.125), dynd::complex<double>(-2.5, 1.0),
                                     dynd::complex<double>(12.125, 12345.0)}));
 }
-*/
 
-/*
 TEST(Sum, 2D)
 {
   EXPECT_ARRAY_EQ(15, nd::sum(nd::array{{0, 1, 2}, {3, 4, 5}}));
 }
-*/
+
+TEST(Sum, Summation) {
+  EXPECT_ARRAY_EQ(10.875, nd::sum({nd::array{1.25, -2.5, 12.125}}, {{"summation", summation_serial}}));
+  EXPECT_ARRAY_EQ(10.875, nd::sum({nd::array{1.25, -2.5, 12.125}}, {{"summation", summation_pairwise}}));
+  EXPECT_ARRAY_EQ(10.875, nd::sum({nd::array{1.25, -2.5, 12.125}}, {{"summation", summation_kahan}}));
+  EXPECT_ARRAY_EQ(15, nd::sum({nd::array{{0, 1, 2}, {3, 4, 5}}}, {{"summation", summation_kahan}}));
+  EXPECT_ARRAY_EQ((nd::array{3.0, 5.0, 7.0}), nd::sum({nd::array{{0.0, 1.0, 2.0}, {3.0, 4.0, 5.0}}},
+                                                      {{"axes", {0}}, {"summation", summation_kahan}}));
+
+  // Adding many small values in order loses low-order bits at every step
+  nd::array a = nd::empty(ndt::type("100000 * float32"));
+  double expected = 0.0;
+  for (int i = 0; i < 100000; ++i) {
+    a(i).assign(0.1f);
+    expected += 0.1f;
+  }
+
+  double serial = nd::sum({a}, {{"summation", summation_serial}}).as<float>();
+  double pairwise = nd::sum(a).as<float>();
+  double kahan = nd::sum({a}, {{"summation", summation_kahan}}).as<float>();
+  EXPECT_GT(fabs(serial - expected), 1.0);
+  EXPECT_LT(fabs(pairwise - expected), 1e-2);
+  EXPECT_LT(fabs(kahan - expected), 1e-2);
+
+  // A strided run takes the same path
+  double strided = nd::sum({a(irange().by(2))}, {{"summation", summation_pairwise}}).as<float>();
+  EXPECT_LT(fabs(strided - expected / 2), 1e-2);
+}
@@ -34,14 +34,12 @@ TEST(Callable, Take) {
   intptr_t bvals2[4] = {3, 0, -1, 4};
   b = bvals2;
   c = nd::take(a, b);
-  /*
-    EXPECT_EQ(ndt::type("4 * int"), c.get_type());
-    ASSERT_EQ(4, c.get_dim_size());
-    EXPECT_EQ(4, c(0).as<int>());
-    EXPECT_EQ(1, c(1).as<int>());
-    EXPECT_EQ(5, c(2).as<int>());
-    EXPECT_EQ(5, c(3).as<int>());
-  */
+  EXPECT_EQ(ndt::type("4 * int"), c.get_type());
+  ASSERT_EQ(4, c.get_dim_size());
+  EXPECT_EQ(4, c(0).as<int>());
+  EXPECT_EQ(1, c(1).as<int>());
+  EXPECT_EQ(5, c(2).as<int>());
+  EXPECT_EQ(5, c(3).as<int>());
 }
 
 TEST(Callable, TakeOfArray) {
@@ -80,3 +78,77 @@ TEST(Callable, TakeOfArray) {
     EXPECT_EQ(3, c(3, 1).as<int>());
   */
 }
+
+TEST(Callable, TakeMasked) {
+  // Masks with long runs of either value, and ones that alternate quickly
+  for (int period : {1, 3, 7, 64}) {
+    int n = 1000;
+    nd::array a = nd::empty(n, ndt::make_type<int64_t>());
+    nd::array b = nd::empty(n, ndt::make_type<bool1>());
+    for (int i = 0; i < n; ++i) {
+      a(i).assign(10 * i);
+      b(i).assign(bool1((i / period) % 2 == 0 || i % 5 == 0));
+    }
+
+    nd::array c = nd::take(a, b);
+    EXPECT_EQ(ndt::type("var * int64"), c.get_type());
+    intptr_t j = 0;
+    for (int i = 0; i < n; ++i) {
+      if ((i / period) % 2 == 0 || i % 5 == 0) {
+        ASSERT_LT(j, c.get_dim_size());
+        EXPECT_EQ(10 * i, c(j).as<int64_t>());
+        ++j;
+      }
+    }
+    EXPECT_EQ(j, c.get_dim_size());
+
+    // A strided source takes the general path
+    nd::array d = nd::take(a(irange().by(2)), b(irange() < n / 2));
+    j = 0;
+    for (int i = 0; i < n / 2; ++i) {
+      if ((i / period) % 2 == 0 || i % 5 == 0) {
+        ASSERT_LT(j, d.get_dim_size());
+        EXPECT_EQ(20 * i, d(j).as<int64_t>());
+        ++j;
+      }
+    }
+    EXPECT_EQ(j, d.get_dim_size());
+  }
+
+  // Nothing selected
+  bool1 bvals[3] = {bool1(false), bool1(false), bool1(false)};
+  EXPECT_EQ(0, nd::take(nd::array{1.5, 2.5, 3.5}, bvals).get_dim_size());
+}
+
+TEST(Callable, TakeIndexed) {
+  int n = 1000;
+  nd::array a = nd::empty(n, ndt::make_type<double>());
+  nd::array b = nd::empty(2 * n, ndt::make_type<intptr_t>());
+  for (int i = 0; i < n; ++i) {
+    a(i).assign(0.5 * i);
+  }
+  // Scattered indices, with every other one counted from the end
+  for (int i = 0; i < 2 * n; ++i) {
+    intptr_t ix = (i * 7919) % n;
+    b(i).assign((i % 2 == 0) ? ix : ix - n);
+  }
+
+  nd::array c = nd::take(a, b);
+  ASSERT_EQ(2 * n, c.get_dim_size());
+  for (int i = 0; i < 2 * n; ++i) {
+    EXPECT_EQ(0.5 * ((i * 7919) % n), c(i).as<double>());
+  }
+
+  // Strided indices
+  c = nd::take(a, b(irange().by(3)));
+  ASSERT_EQ((2 * n + 2) / 3, c.get_dim_size());
+  for (intptr_t i = 0; i < c.get_dim_size(); ++i) {
+    EXPECT_EQ(0.5 * ((3 * i * 7919) % n), c(i).as<double>());
+  }
+
+  // Indices out of bounds in either direction
+  intptr_t bvals[3] = {0, 5, 1};
+  EXPECT_THROW(nd::take(nd::array{1, 2, 3}, bvals), index_out_of_bounds);
+  intptr_t bvals2[3] = {0, -4, 1};
+  EXPECT_THROW(nd::take(nd::array{1, 2, 3}, bvals2), index_out_of_bounds);
+}
@@ -21,3 +21,33 @@ TEST(Where, Untitled) {
   EXPECT_ARRAY_EQ(nd::array({static_cast<intptr_t>(2)}), res(1));
   EXPECT_ARRAY_EQ(nd::array({static_cast<intptr_t>(3)}), res(2));
 }
+
+TEST(Where, Dense) {
+  nd::callable f = nd::functional::where([](int x) { return x % 3 != 0; });
+
+  // Enough elements to span several blocks of the predicate
+  int n = 10000;
+  nd::array a = nd::empty(n, ndt::make_type<int>());
+  for (int i = 0; i < n; ++i) {
+    a(i).assign(i);
+  }
+
+  nd::array res = f(a);
+  intptr_t count = 0;
+  for (int i = 0; i < n; ++i) {
+    if (i % 3 != 0) {
+      ++count;
+    }
+  }
+  ASSERT_EQ(count, res.get_dim_size());
+  for (intptr_t i = 0; i < count; ++i) {
+    EXPECT_EQ(i + i / 2 + 1, res(i, 0).as<intptr_t>());
+  }
+
+  // Every element matches, or none do
+  res = f(nd::array{1, 2, 4, 5, 7});
+  ASSERT_EQ(5, res.get_dim_size());
+  EXPECT_EQ(4, res(4, 0).as<intptr_t>());
+  res = f(nd::array{0, 3, 6});
+  EXPECT_EQ(0, res.get_dim_size());
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdint>
+
+#include <dynd/arena.hpp>
+#include <dynd/arithmetic.hpp>
+#include <dynd/array.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/kernels/kernel_builder.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Arena, Allocate) {
+  arena a(256);
+  EXPECT_EQ(0u, a.capacity());
+
+  char *prev = NULL;
+  for (size_t size = 1; size < 100; ++size) {
+    char *ptr = reinterpret_cast<char *>(a.allocate(size));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 16);
+    if (prev != NULL) {
+      EXPECT_NE(prev, ptr);
+    }
+    memset(ptr, 0xff, size);
+    prev = ptr;
+  }
+
+  // An allocation larger than the block size gets a block of its own
+  size_t capacity = a.capacity();
+  a.allocate(1000);
+  EXPECT_LE(capacity + 1000, a.capacity());
+}
+
+TEST(Arena, Scope) {
+  arena a(256);
+
+  void *first;
+  {
+    arena::scope s(a);
+    first = a.allocate(16);
+    a.allocate(1000);
+    a.allocate(100);
+  }
+  size_t capacity = a.capacity();
+
+  // Once rewound, the same memory is handed out again without new blocks
+  for (int i = 0; i < 10; ++i) {
+    arena::scope s(a);
+    EXPECT_EQ(first, a.allocate(16));
+    a.allocate(1000);
+    a.allocate(100);
+    EXPECT_EQ(capacity, a.capacity());
+  }
+
+  // Nested scopes rewind to their own start
+  arena::scope outer(a);
+  void *ptr = a.allocate(32);
+  {
+    arena::scope inner(a);
+    a.allocate(64);
+  }
+  EXPECT_EQ(reinterpret_cast<char *>(ptr) + 32, a.allocate(8));
+}
+
+TEST(Arena, KernelBuilder) {
+  arena a;
+  arena::scope s(a);
+
+  nd::kernel_builder kb(nullptr, &a);
+  size_t static_capacity = kb.capacity();
+  kb.emplace_back(static_capacity + 1);
+  EXPECT_LT(static_capacity, kb.capacity());
+  EXPECT_LT(0u, a.capacity());
+
+  // The contents are kept as the storage grows, past the prefix that is destroyed with the builder
+  *kb.get_at<int>(static_capacity) = 7;
+  kb.emplace_back(4 * static_capacity);
+  EXPECT_EQ(7, *kb.get_at<int>(static_capacity));
+}
+
+TEST(Arena, Call) {
+  nd::array a = nd::empty(ndt::make_type<ndt::fixed_dim_type>(10, ndt::make_type<int>()));
+  a.assign(1);
+
+  // After a first call has grown the arena of the thread, the same call doesn't grow it
+  nd::array b = a + a;
+  size_t capacity = arena::get().capacity();
+  for (int i = 0; i < 10; ++i) {
+    b = a + a;
+    EXPECT_EQ(capacity, arena::get().capacity());
+  }
+  EXPECT_EQ(2, b(0).as<int>());
+
+  // A caller can provide the arena
+  arena kernel_arena;
+  const ndt::type src_tp[2] = {a.get_type(), a.get_type()};
+  const char *src_arrmeta[2] = {a->metadata(), a->metadata()};
+  const nd::array src_data[2] = {a, a};
+  ndt::type dst_tp = nd::add->get_ret_type();
+  b = nd::add->call(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL, std::map<std::string, ndt::type>(),
+                    &kernel_arena);
+  EXPECT_EQ(2, b(9).as<int>());
+}
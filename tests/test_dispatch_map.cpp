@@ -7,7 +7,9 @@
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 
+#include <dynd/callable.hpp>
 #include <dynd/dispatcher.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/type_registry.hpp>
@@ -129,3 +131,64 @@ TEST(Dispatcher, Ternary) {
   EXPECT_EQ(0, dispatcher(option_id, int64_id));
 }
 */
+
+TEST(Dispatcher, Cache) {
+  nd::callable f0([](int32_t x) { return x; });
+  nd::callable f1([](double x) { return x; });
+  nd::callable f2([](int64_t x) { return x; });
+
+  dispatcher<1, nd::callable> dispatcher(
+      [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+         ndt::type *res) { res[0] = src_tp[0]; },
+      {f0, f1});
+
+  ndt::type int32_tp = ndt::make_type<int32_t>();
+  ndt::type float64_tp = ndt::make_type<double>();
+  ndt::type int64_tp = ndt::make_type<int64_t>();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(f0.get(), dispatcher(ndt::type(), 1, &int32_tp).get());
+    EXPECT_EQ(f1.get(), dispatcher(ndt::type(), 1, &float64_tp).get());
+    EXPECT_THROW(dispatcher(ndt::type(), 1, &int64_tp), out_of_range);
+  }
+
+  // Inserting a child invalidates the previous dispatches
+  dispatcher.insert(f2);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(f0.get(), dispatcher(ndt::type(), 1, &int32_tp).get());
+    EXPECT_EQ(f1.get(), dispatcher(ndt::type(), 1, &float64_tp).get());
+    EXPECT_EQ(f2.get(), dispatcher(ndt::type(), 1, &int64_tp).get());
+  }
+}
+
+TEST(Dispatcher, ConcurrentCache) {
+  std::vector<nd::callable> children{
+      nd::callable([](int8_t x) { return x; }),   nd::callable([](int16_t x) { return x; }),
+      nd::callable([](int32_t x) { return x; }),  nd::callable([](int64_t x) { return x; }),
+      nd::callable([](uint8_t x) { return x; }),  nd::callable([](uint16_t x) { return x; }),
+      nd::callable([](uint32_t x) { return x; }), nd::callable([](uint64_t x) { return x; }),
+      nd::callable([](float x) { return x; }),    nd::callable([](double x) { return x; })};
+
+  dispatcher<1, nd::callable> dispatcher(
+      [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+         ndt::type *res) { res[0] = src_tp[0]; },
+      children.begin(), children.end());
+
+  // The threads fill the cache in different orders, so lookups race with the table being grown
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < 1000; ++i) {
+        ndt::type src_tp = children[(t + i) % children.size()]->get_arg_types()[0];
+        if (dispatcher(ndt::type(), 1, &src_tp)->get_arg_types()[0] != src_tp) {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(0, failures);
+}
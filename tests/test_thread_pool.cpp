@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/gtest.hpp>
+#include <dynd/thread_pool.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(ThreadPool, Run) {
+  thread_pool pool(3);
+  EXPECT_EQ(4u, pool.get_nthreads());
+  EXPECT_FALSE(thread_pool::in_task());
+
+  for (size_t nthreads = 1; nthreads <= 6; ++nthreads) {
+    vector<atomic<int>> count(1000);
+    for (atomic<int> &c : count) {
+      c = 0;
+    }
+    vector<int> busy(nthreads, 0);
+
+    pool.run(nthreads, count.size(), [&](size_t task, size_t thread) {
+      EXPECT_TRUE(thread_pool::in_task());
+      EXPECT_LT(thread, nthreads);
+      // No two tasks share a thread index at the same time
+      EXPECT_EQ(0, busy[thread]++);
+      ++count[task];
+      --busy[thread];
+    });
+
+    for (atomic<int> &c : count) {
+      EXPECT_EQ(1, c);
+    }
+  }
+  EXPECT_FALSE(thread_pool::in_task());
+}
+
+TEST(ThreadPool, Nested) {
+  thread_pool pool(2);
+
+  atomic<int> total(0);
+  pool.run(3, 8, [&](size_t DYND_UNUSED(task), size_t DYND_UNUSED(thread)) {
+    // A run from inside a task stays on the current thread
+    pool.run(3, 4, [&](size_t DYND_UNUSED(inner_task), size_t inner_thread) {
+      EXPECT_EQ(0u, inner_thread);
+      ++total;
+    });
+  });
+  EXPECT_EQ(32, total);
+}
+
+TEST(ThreadPool, Exception) {
+  thread_pool pool(2);
+
+  EXPECT_THROW(pool.run(3, 100,
+                        [](size_t task, size_t DYND_UNUSED(thread)) {
+                          if (task == 50) {
+                            throw runtime_error("task failed");
+                          }
+                        }),
+               runtime_error);
+
+  // The pool is still usable afterwards
+  atomic<int> total(0);
+  pool.run(3, 100, [&](size_t DYND_UNUSED(task), size_t DYND_UNUSED(thread)) { ++total; });
+  EXPECT_EQ(100, total);
+}
@@ -435,4 +435,28 @@ TEST(StructType, InvalidFieldName) {
   EXPECT_THROW(s.p("z"), invalid_argument);
 }
 
+TEST(StructType, FieldIndex) {
+  std::vector<std::string> names;
+  std::vector<ndt::type> types;
+  for (int i = 0; i < 300; ++i) {
+    names.push_back("field" + std::to_string(i));
+    types.push_back(ndt::make_type<int32_t>());
+  }
+  ndt::type tp = ndt::make_type<ndt::struct_type>(names, types);
+  const ndt::struct_type *sd = tp.extended<ndt::struct_type>();
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(i, sd->get_field_index(names[i]));
+  }
+  EXPECT_EQ(-1, sd->get_field_index("field"));
+  EXPECT_EQ(-1, sd->get_field_index("field300"));
+
+  // A name inside a larger buffer
+  const char *buf = "\"field42\": 1";
+  EXPECT_EQ(42, sd->get_field_index(buf + 1, 7));
+  EXPECT_EQ(4, sd->get_field_index(buf + 1, 6));
+
+  tp = ndt::make_type<ndt::struct_type>();
+  EXPECT_EQ(-1, tp.extended<ndt::struct_type>()->get_field_index("x"));
+}
+
 TEST(StructType, IDOf) { EXPECT_EQ(struct_id, ndt::id_of<ndt::struct_type>::value); }
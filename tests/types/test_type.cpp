@@ -12,8 +12,13 @@
 #include <dynd/types/any_kind_type.hpp>
 #include <dynd/types/bool_kind_type.hpp>
 #include <dynd/types/bytes_type.hpp>
+#include <dynd/types/categorical_type.hpp>
 #include <dynd/types/fixed_bytes_kind_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 #include <dynd/gtest.hpp>
 
 using namespace std;
@@ -161,6 +166,56 @@ TEST(Type, BasicConstructor) {
   EXPECT_EQ(d, ndt::type(d.str()));
 }
 
+TEST(Type, Intern) {
+  // Structurally equal types share one instance
+  ndt::type a = ndt::make_type<ndt::struct_type>(
+      {{ndt::make_fixed_dim(3, ndt::make_type<int>()), "x"}, {ndt::make_type<ndt::string_type>(), "y"}});
+  ndt::type b = ndt::type("{x: 3 * int32, y: string}");
+  EXPECT_TRUE(a.extended()->is_interned());
+  EXPECT_EQ(a.extended(), b.extended());
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.hash(), b.hash());
+  EXPECT_EQ(std::hash<ndt::type>()(a), std::hash<ndt::type>()(b));
+
+  // Types that differ anywhere stay distinct
+  ndt::type c = ndt::type("{x: 3 * int32, z: string}");
+  ndt::type d = ndt::type("{x: 4 * int32, y: string}");
+  EXPECT_NE(a, c);
+  EXPECT_NE(a, d);
+  EXPECT_NE(a.extended(), c.extended());
+
+  // The interning table holds no references of its own
+  ndt::type e = ndt::type("var * {a: ?float64}");
+  EXPECT_EQ(1, e.extended()->get_use_count());
+  ndt::type f = ndt::make_type<ndt::var_dim_type>(
+      ndt::make_type<ndt::struct_type>({{ndt::make_type<ndt::option_type>(ndt::make_type<double>()), "a"}}));
+  EXPECT_EQ(e.extended(), f.extended());
+  EXPECT_EQ(2, e.extended()->get_use_count());
+}
+
+TEST(Type, Hash) {
+  // Types that differ only in their parameters hash apart, rather than colliding on their id
+  std::vector<std::pair<const char *, const char *>> pairs{{"fixed_string[10, 'utf8']", "fixed_string[12, 'utf8']"},
+                                                            {"fixed_string[10, 'utf8']", "fixed_string[10, 'utf16']"},
+                                                            {"fixed_bytes[4]", "fixed_bytes[8]"},
+                                                            {"fixed_bytes[8, align=4]", "fixed_bytes[8, align=8]"},
+                                                            {"char['ascii']", "char['utf32']"},
+                                                            {"T", "S"},
+                                                            {"N * int32", "M * int32"},
+                                                            {"A... * int32", "B... * int32"}};
+  for (const auto &pair : pairs) {
+    EXPECT_EQ(ndt::type(pair.first).hash(), ndt::type(pair.first).hash());
+    EXPECT_NE(ndt::type(pair.first).hash(), ndt::type(pair.second).hash());
+  }
+
+  ndt::type a = ndt::make_type<ndt::categorical_type>(nd::array{"foo", "bar", "baz"});
+  ndt::type b = ndt::make_type<ndt::categorical_type>(nd::array{"foo", "bar", "baz"});
+  ndt::type c = ndt::make_type<ndt::categorical_type>(nd::array{"foo", "bar", "qux"});
+  EXPECT_EQ(a.extended(), b.extended());
+  EXPECT_EQ(a.hash(), b.hash());
+  EXPECT_NE(a.hash(), c.hash());
+}
+
 TEST(TypeFor, InitializerList) {
   EXPECT_EQ(ndt::make_type<ndt::fixed_dim_type>(1, ndt::make_type<int>()), ndt::type_for({0}));
   EXPECT_EQ(ndt::make_type<ndt::fixed_dim_type>(2, ndt::make_type<int>()), ndt::type_for({10, -2}));